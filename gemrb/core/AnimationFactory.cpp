@@ -154,6 +154,48 @@ Sprite2D* AnimationFactory::GetPaperdollImage(ieDword *Colors,
 	return spr;
 }
 
+/* returns where each row of the RLE frame data starts, so decoding can begin at any row */
+const RLERowOffset* AnimationFactory::GetRLERowIndex(const void* pixels, int width, int height, ieByte colorkey)
+{
+	if (!pixels || width <= 0 || height <= 0) {
+		return NULL;
+	}
+
+	std::map<const void*, RLERowIndex>::iterator it = rleRowIndices.find(pixels);
+	if (it != rleRowIndices.end()) {
+		const RLERowIndex& index = it->second;
+		// the frame was indexed with a different transparency index, can't use it
+		if (index.colorkey != colorkey || (int) index.rows.size() != height) {
+			return NULL;
+		}
+		return &index.rows[0];
+	}
+
+	RLERowIndex& index = rleRowIndices[pixels];
+	index.colorkey = colorkey;
+	index.rows.resize(height);
+
+	const ieByte* data = (const ieByte*) pixels;
+	const ieByte* rle = data;
+	unsigned int pixel = 0;
+	int row = 0;
+	while (row < height) {
+		// this code covers the pixels [pixel, pixel + count)
+		ieDword offset = (ieDword) (rle - data);
+		unsigned int count = 1;
+		if (*rle++ == colorkey) {
+			count = (*rle++) + 1;
+		}
+		while (row < height && (unsigned int) row * width < pixel + count) {
+			index.rows[row].offset = offset;
+			index.rows[row].lead = (ieWord) (row * width - pixel);
+			row++;
+		}
+		pixel += count;
+	}
+	return &index.rows[0];
+}
+
 void AnimationFactory::IncDataRefCount()
 {
 	++datarefcount;
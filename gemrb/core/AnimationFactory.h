@@ -27,11 +27,22 @@
 #include "Animation.h"
 #include "AnimStructures.h"
 #include "FactoryObject.h"
+#include "Sprite2D.h"
+
+#include <map>
+#include <vector>
 
 namespace GemRB {
 
 class GEM_EXPORT AnimationFactory : public FactoryObject {
 private:
+	struct RLERowIndex {
+		ieByte colorkey;
+		std::vector<RLERowOffset> rows;
+	};
+	// built on first use, per frame (keyed by its pixel data)
+	std::map<const void*, RLERowIndex> rleRowIndices;
+
 	std::vector< Sprite2D*> frames;
 	std::vector< CycleEntry> cycles;
 	unsigned short* FLTable;	// Frame Lookup Table
@@ -54,6 +65,8 @@ public:
 	Sprite2D* GetPaperdollImage(ieDword *Colors, Sprite2D *&Picture2,
 		unsigned int type) const;
 
+	const RLERowOffset* GetRLERowIndex(const void* pixels, int width, int height, ieByte colorkey);
+
 	void IncDataRefCount();
 	void DecDataRefCount();
 };
@@ -18,14 +18,109 @@
 
 #include "FileCache.h"
 
+#include "win32def.h"
+
 #include "Compressor.h"
 #include "Interface.h"
 #include "PluginMgr.h"
 #include "System/FileStream.h"
 #include "System/VFS.h"
 
+#include <ctime>
+#include <map>
+#include <string>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 namespace GemRB {
 
+// decompressed archives are stamped with the size and modification time of
+// their source, so they can be reused by later runs as long as it is unchanged
+struct CachedArchive {
+	std::string source;
+	unsigned long sourceSize;
+	unsigned long sourceTime;
+	unsigned long size;
+	unsigned long lastUse;
+};
+
+typedef std::map<std::string, CachedArchive> ArchiveIndex;
+
+#define CACHE_INDEX "archives.idx"
+
+static ArchiveIndex archives;
+static bool archivesLoaded = false;
+
+static bool StatFile(const char* path, unsigned long &size, unsigned long &mtime)
+{
+	struct stat buf;
+	if (stat(path, &buf) < 0) {
+		return false;
+	}
+	size = (unsigned long) buf.st_size;
+	mtime = (unsigned long) buf.st_mtime;
+	return true;
+}
+
+static void LoadArchiveIndex()
+{
+	if (archivesLoaded) {
+		return;
+	}
+	archivesLoaded = true;
+
+	char path[_MAX_PATH];
+	PathJoin(path, core->CachePath, CACHE_INDEX, NULL);
+	FILE *fp = fopen(path, "r");
+	if (!fp) {
+		return;
+	}
+	// one line per archive: name, the stamps, then the source path
+	char name[_MAX_PATH], source[_MAX_PATH];
+	CachedArchive entry;
+	while (fscanf(fp, "%259s %lu %lu %lu %lu %259[^\n]", name, &entry.sourceSize,
+			&entry.sourceTime, &entry.size, &entry.lastUse, source) == 6) {
+		entry.source = source;
+		archives[name] = entry;
+	}
+	fclose(fp);
+}
+
+static void SaveArchiveIndex()
+{
+	char path[_MAX_PATH];
+	PathJoin(path, core->CachePath, CACHE_INDEX, NULL);
+	FILE *fp = fopen(path, "w");
+	if (!fp) {
+		Log(ERROR, "FileCache", "Cannot write %s.", path);
+		return;
+	}
+	ArchiveIndex::const_iterator it;
+	for (it = archives.begin(); it != archives.end(); ++it) {
+		const CachedArchive &entry = it->second;
+		fprintf(fp, "%s %lu %lu %lu %lu %s\n", it->first.c_str(), entry.sourceSize,
+			entry.sourceTime, entry.size, entry.lastUse, entry.source.c_str());
+	}
+	fclose(fp);
+}
+
+// checks both the source and the cached copy, which may be a leftover of an interrupted run
+static bool IsUpToDate(const std::string &name, const CachedArchive &entry)
+{
+	unsigned long size, mtime;
+	if (!StatFile(entry.source.c_str(), size, mtime)) {
+		return false;
+	}
+	if (size != entry.sourceSize || mtime != entry.sourceTime) {
+		return false;
+	}
+	char path[_MAX_PATH];
+	PathJoin(path, core->CachePath, name.c_str(), NULL);
+	return StatFile(path, size, mtime) && size == entry.size;
+}
+
 DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int length, bool overwrite)
 {
 	if (!core->IsAvailable(PLUGIN_COMPRESSION_ZLIB)) {
@@ -54,4 +149,100 @@ DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int
 	return FileStream::OpenFile(path);
 }
 
+DataStream* CacheArchive(DataStream *compressed, const char* source, int length)
+{
+	char fname[_MAX_PATH];
+	ExtractFileFromPath(fname, source);
+
+	LoadArchiveIndex();
+	// forget the old copy first, in case we don't finish writing the new one
+	if (archives.erase(fname)) {
+		SaveArchiveIndex();
+	}
+
+	DataStream *stream = CacheCompressedStream(compressed, fname, length, true);
+	CachedArchive entry;
+	if (!stream || !StatFile(source, entry.sourceSize, entry.sourceTime)) {
+		return stream;
+	}
+	entry.source = source;
+	entry.size = stream->Size();
+	entry.lastUse = (unsigned long) time(NULL);
+	archives[fname] = entry;
+	SaveArchiveIndex();
+	return stream;
+}
+
+DataStream* OpenCachedArchive(const char* source)
+{
+	char fname[_MAX_PATH];
+	ExtractFileFromPath(fname, source);
+
+	LoadArchiveIndex();
+	ArchiveIndex::iterator it = archives.find(fname);
+	if (it == archives.end() || it->second.source != source || !IsUpToDate(it->first, it->second)) {
+		return NULL;
+	}
+
+	char path[_MAX_PATH];
+	PathJoin(path, core->CachePath, fname, NULL);
+	DataStream *stream = FileStream::OpenFile(path);
+	if (stream) {
+		it->second.lastUse = (unsigned long) time(NULL);
+		SaveArchiveIndex();
+	}
+	return stream;
+}
+
+void PruneCache(unsigned long limit)
+{
+	LoadArchiveIndex();
+
+	// in bytes, which can exceed 32 bits
+	unsigned __int64 total = 0;
+	unsigned __int64 limitBytes = (unsigned __int64) limit * 1024 * 1024;
+	ArchiveIndex::iterator it = archives.begin();
+	while (it != archives.end()) {
+		if (IsUpToDate(it->first, it->second)) {
+			total += it->second.size;
+			++it;
+		} else {
+			archives.erase(it++);
+		}
+	}
+	while (limit && total > limitBytes) {
+		ArchiveIndex::iterator oldest = archives.begin();
+		for (it = archives.begin(); it != archives.end(); ++it) {
+			if (it->second.lastUse < oldest->second.lastUse) {
+				oldest = it;
+			}
+		}
+		total -= oldest->second.size;
+		archives.erase(oldest);
+	}
+
+	// everything else is scratch space of the previous run
+	DirectoryIterator dir(core->CachePath);
+	if (dir) {
+		do {
+			const char *name = dir.GetName();
+			if (dir.IsDirectory() || name[0] == '.') {
+				continue;
+			}
+			// keep the indices too (ours and the directory listings)
+			const char *ext = strrchr(name, '.');
+			if ((ext && !stricmp(ext, ".idx")) || archives.count(name)) {
+				continue;
+			}
+			char path[_MAX_PATH];
+			dir.GetFullPath(path);
+			unlink(path);
+		} while (++dir);
+	}
+	SaveArchiveIndex();
+	if (archives.size()) {
+		Log(MESSAGE, "FileCache", "Keeping %d cached archives (%luKb).", (int) archives.size(), (unsigned long) (total/1024));
+	}
+}
+
 }
@@ -25,6 +25,14 @@ namespace GemRB {
 
 GEM_EXPORT DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int length = 0, bool overwrite = false);
 
+/** Decompresses the archive at source into the cache and keeps it across restarts */
+GEM_EXPORT DataStream* CacheArchive(DataStream *compressed, const char* source, int length);
+/** Returns the cached copy of the archive at source, if it is still up to date */
+GEM_EXPORT DataStream* OpenCachedArchive(const char* source);
+/** Empties the cache except for up to date archives and *.idx files, dropping the least
+ * recently used ones until they fit into limit megabytes (0 means no limit) */
+GEM_EXPORT void PruneCache(unsigned long limit);
+
 }
 
 #endif
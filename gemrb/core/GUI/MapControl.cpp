@@ -132,16 +132,28 @@ void MapControl::DrawFog(const Region& rgn)
 	int w = MyMap->GetWidth() / 2;
 	int h = MyMap->GetHeight() / 2;
 
+	// merge horizontal runs of fogged cells and draw them as one batch
+	std::vector<Region> fogged;
 	for (int y = 0; y < h; y++) {
-		for (int x = 0; x < w; x++) {
-			Point p( (short) (MAP_MULT * x), (short) (MAP_MULT * y) );
-			bool visible = MyMap->IsVisible( p, true );
-			if (! visible) {
-				Region rgn = Region ( MAP_TO_SCREENX(MAP_DIV * x), MAP_TO_SCREENY(MAP_DIV * y), MAP_DIV, MAP_DIV );
-				video->DrawRect( rgn, colors[black] );
+		int runStart = -1;
+		for (int x = 0; x <= w; x++) {
+			bool visible = true;
+			if (x < w) {
+				Point p( (short) (MAP_MULT * x), (short) (MAP_MULT * y) );
+				visible = MyMap->IsVisible( p, true );
+			}
+			if (!visible) {
+				if (runStart < 0) runStart = x;
+			} else if (runStart >= 0) {
+				fogged.push_back(Region( MAP_TO_SCREENX(MAP_DIV * runStart), MAP_TO_SCREENY(MAP_DIV * y),
+					MAP_DIV * (x - runStart), MAP_DIV ));
+				runStart = -1;
 			}
 		}
 	}
+	if (!fogged.empty()) {
+		video->DrawRects( &fogged[0], fogged.size(), colors[black] );
+	}
 }
 
 // To be called after changes in control's or screen geometry
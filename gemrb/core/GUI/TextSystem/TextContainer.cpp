@@ -327,10 +327,10 @@ Size ContentContainer::ContentFrame() const
 
 void ContentContainer::AppendContent(Content* content)
 {
-	if (contents.empty())
-		InsertContentAfter(content, 0);
-	else
-		InsertContentAfter(content, *(--contents.end()));
+	// nothing to search for or to move, only the new content needs a layout
+	content->parent = this;
+	contents.push_back(content);
+	LayoutContentsFrom(--contents.end());
 }
 
 void ContentContainer::InsertContentAfter(Content* newContent, const Content* existing)
@@ -406,8 +406,9 @@ Region ContentContainer::BoundingBoxForContent(const Content* c) const
 
 const ContentContainer::Layout& ContentContainer::LayoutForContent(const Content* c) const
 {
-	ContentLayout::const_iterator it = std::find(layout.begin(), layout.end(), c);
-	if (it != layout.end()) {
+	// we are mostly asked about the content we have just laid out, so search from the end
+	ContentLayout::const_reverse_iterator it = std::find(layout.rbegin(), layout.rend(), c);
+	if (it != layout.rend()) {
 		return *it;
 	}
 	static Layout NullLayout(NULL, Regions());
@@ -470,12 +471,16 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 		it++;
 	}
 	// clear the existing layout, but only for "it" and onward
-	ContentList::const_iterator clearit = it;
-	for (; clearit != contents.end(); ++clearit) {
-		ContentLayout::iterator i = std::find(layout.begin(), layout.end(), *clearit);
-		if (i != layout.end()) {
-			layoutPoint = Point(); // reset cached layoutPoint
-			layout.erase(i);
+	// the layout is in content order, so if it ends with the content before "it"
+	// (always the case when appending) there is nothing to clear
+	if (!layout.empty() && (!exContent || layout.back().content != exContent)) {
+		ContentList::const_iterator clearit = it;
+		for (; clearit != contents.end(); ++clearit) {
+			ContentLayout::reverse_iterator i = std::find(layout.rbegin(), layout.rend(), *clearit);
+			if (i != layout.rend()) {
+				layoutPoint = Point(); // reset cached layoutPoint
+				layout.erase(--i.base());
+			}
 		}
 	}
 
@@ -522,8 +527,7 @@ void ContentContainer::DrawContentsInRegions(const Regions& rgns, const Point& o
 
 	// should only have 1 region
 	const Region& rgn = rgns.front();
-
-	// TODO: intersect with the screen clip so we can bail out even earlier
+	const Region& screenClip = core->GetVideoDriver()->GetScreenClip();
 
 	const Point& drawOrigin = rgn.Origin();
 	Point drawPoint = drawOrigin;
@@ -538,9 +542,32 @@ void ContentContainer::DrawContentsInRegions(const Regions& rgns, const Point& o
 	core->GetVideoDriver()->DrawRect(dr, ColorWhite, false);
 #endif
 
+	// only draw what is in view, long (scrolled) histories are mostly out of it
+	// the layout is ordered top to bottom, so binary search for the first visible one
+	// the same way ContentAtPoint does
+	int clipTop = screenClip.y - offset.y - parentOffset.y;
+	size_t count = layout.size();
+	while (count > 0) {
+		size_t step = count / 2;
+		ContentLayout::const_iterator mid = it + step;
+		const Region& bounds = Region::RegionEnclosingRegions((*mid).regions);
+		if (bounds.y + bounds.h <= clipTop) {
+			it = ++mid;
+			count -= step + 1;
+		} else {
+			count = step;
+		}
+	}
+
 	for (; it != layout.end(); ++it) {
 		const Layout& l = *it;
 		assert(drawPoint.x <= drawOrigin.x + frame.w);
+		Region bounds = Region::RegionEnclosingRegions(l.regions);
+		bounds.x += offset.x + parentOffset.x;
+		bounds.y += offset.y + parentOffset.y;
+		if (bounds.y >= screenClip.y + screenClip.h) {
+			break;
+		}
 		l.content->DrawContentsInRegions(l.regions, offset + parentOffset);
 	}
 }
@@ -550,6 +577,7 @@ void ContentContainer::DeleteContentsInRect(Region exclusion)
 	int top = exclusion.y;
 	int bottom = top;
 	const Content* content;
+	Point oldLayoutPoint = layoutPoint;
 	while (const Region* rgn = ContentRegionForRect(exclusion)) {
 		content = ContentAtPoint(rgn->Origin());
 		assert(content);
@@ -560,7 +588,28 @@ void ContentContainer::DeleteContentsInRect(Region exclusion)
 		delete RemoveContent(content, false);
 	}
 
-	// TODO: we could optimize this to only layout content after exclusion.y
+	// trimming whole lines off the top (like the message log does) leaves the rest
+	// of the content where it was, just higher up, so we can move it instead of
+	// laying everything out again
+	if (top == 0 && !layout.empty()) {
+		const Region& first = layout.front().regions.front();
+		if (first.x == 0 && first.y == bottom) {
+			ContentLayout::iterator it = layout.begin();
+			for (; it != layout.end(); ++it) {
+				Regions::iterator rit = (*it).regions.begin();
+				for (; rit != (*it).regions.end(); ++rit) {
+					(*rit).y -= bottom;
+				}
+			}
+			contentBounds.h -= bottom;
+			layoutPoint = oldLayoutPoint;
+			layoutPoint.y -= bottom;
+			if (parent) {
+				parent->LayoutContentsFrom(this);
+			}
+			return;
+		}
+	}
 	LayoutContentsFrom(contents.begin());
 }
 
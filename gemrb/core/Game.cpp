@@ -1556,6 +1556,19 @@ void Game::UpdateScripts()
 	for (idx=0;idx<Maps.size();idx++) {
 		Maps[idx]->UpdateScripts();
 	}
+	// then whatever reaches across maps, in a fixed order
+	bool moved = false;
+	for (idx=0;idx<Maps.size();idx++) {
+		if (Maps[idx]->ResolvePendingExits()) {
+			moved = true;
+		}
+	}
+	// don't draw actors that already left (or miss the ones that arrived)
+	if (moved) {
+		for (idx=0;idx<Maps.size();idx++) {
+			Maps[idx]->RefreshQueues();
+		}
+	}
 
 	if (PartyAttack) {
 		//ChangeSong will set the battlesong only if CombatCounter is nonzero
@@ -1615,6 +1628,41 @@ void Game::UpdateScripts()
 	}
 }
 
+// FNV-1a, good enough to spot diverging runs
+static inline void HashDword(ieDword &hash, ieDword value)
+{
+	for (int i = 0; i < 4; i++) {
+		hash ^= (value >> (i * 8)) & 0xff;
+		hash *= 16777619;
+	}
+}
+
+ieDword Game::GetStateHash() const
+{
+	ieDword hash = 2166136261u;
+
+	HashDword(hash, GameTime);
+	HashDword(hash, PartyGold);
+	HashDword(hash, (ieDword) Maps.size());
+	for (size_t idx = 0; idx < Maps.size(); idx++) {
+		Map *map = Maps[idx];
+		int count = map->GetActorCount(true);
+		HashDword(hash, count);
+		for (int i = 0; i < count; i++) {
+			const Actor *actor = map->GetActor(i, true);
+			HashDword(hash, actor->GetGlobalID());
+			HashDword(hash, (actor->Pos.x << 16) | (actor->Pos.y & 0xffff));
+			HashDword(hash, (actor->Destination.x << 16) | (actor->Destination.y & 0xffff));
+			HashDword(hash, actor->GetOrientation());
+			HashDword(hash, actor->BaseStats[IE_HITPOINTS]);
+			HashDword(hash, actor->Modified[IE_STATE_ID]);
+			const Action *action = actor->GetCurrentAction();
+			HashDword(hash, action ? action->actionID : 0xffff);
+		}
+	}
+	return hash;
+}
+
 void Game::SetTimedEvent(EventHandler func, int count)
 {
 	event_timer = count;
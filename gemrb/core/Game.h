@@ -469,6 +469,9 @@ public:
 	/** Runs the script engine on the global script and the area scripts
 	areas run scripts on door, infopoint, container, actors too */
 	void UpdateScripts();
+	/** Returns a checksum of the simulation state (time, actor positions,
+	hitpoints, states and actions), used to compare benchmark runs */
+	ieDword GetStateHash() const;
 	/** runs area functionality, sets partyrested trigger */
 	bool RestParty(int checks, int dream, int hp);
 	/** timestop effect initiated by actor */
@@ -1888,6 +1888,21 @@ Action *ParamCopyNoOverride(Action *parameters)
 	return newAction;
 }
 
+Trigger *TriggerCopy(Trigger *trigger)
+{
+	Trigger *newTrigger = new Trigger();
+	newTrigger->triggerID = trigger->triggerID;
+	newTrigger->flags = trigger->flags;
+	newTrigger->int0Parameter = trigger->int0Parameter;
+	newTrigger->int1Parameter = trigger->int1Parameter;
+	newTrigger->int2Parameter = trigger->int2Parameter;
+	newTrigger->pointParameter = trigger->pointParameter;
+	MEMCPY( newTrigger->string0Parameter, trigger->string0Parameter );
+	MEMCPY( newTrigger->string1Parameter, trigger->string1Parameter );
+	newTrigger->objectParameter = ObjectCopy( trigger->objectParameter );
+	return newTrigger;
+}
+
 Trigger *GenerateTriggerCore(const char *src, const char *str, int trIndex, int negate)
 {
 	Trigger *newTrigger = new Trigger();
@@ -33,6 +33,9 @@
 #include "RNG/RNG_SFMT.h"
 #include "System/StringBuffer.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
 //debug flags
@@ -1124,6 +1127,63 @@ static const ObjectLink objectnames[] = {
 	{ NULL,NULL}
 };
 
+//triggers that do nothing but look for a queued TriggerEntry
+struct TriggerEventLink {
+	TriggerFunction Function;
+	unsigned short Event;
+};
+
+static const TriggerEventLink triggerevents[] = {
+	{GameScript::AttackedBy, trigger_attackedby},
+	{GameScript::BecameVisible, trigger_becamevisible},
+	{GameScript::Clicked, trigger_clicked},
+	{GameScript::Closed, trigger_closed},
+	{GameScript::Detected, trigger_detected},
+	{GameScript::Die, trigger_die},
+	{GameScript::Died, trigger_died},
+	{GameScript::Disarmed, trigger_disarmed},
+	{GameScript::DisarmFailed, trigger_disarmfailed},
+	{GameScript::Entered, trigger_entered},
+	{GameScript::HarmlessClosed, trigger_harmlessclosed},
+	{GameScript::HarmlessEntered, trigger_harmlessentered},
+	{GameScript::HarmlessOpened, trigger_harmlessopened},
+	{GameScript::Heard, trigger_heard},
+	{GameScript::Help_Trigger, trigger_help},
+	{GameScript::HitBy, trigger_hitby},
+	{GameScript::HotKey, trigger_hotkey},
+	{GameScript::Joins, trigger_joins},
+	{GameScript::Killed, trigger_killed},
+	{GameScript::Leaves, trigger_leaves},
+	{GameScript::NamelessBitTheDust, trigger_namelessbitthedust},
+	{GameScript::OnCreation, trigger_oncreation},
+	{GameScript::OpenFailed, trigger_failedtoopen},
+	{GameScript::Opened, trigger_opened},
+	{GameScript::PartyMemberDied, trigger_partymemberdied},
+	{GameScript::PartyRested, trigger_partyrested},
+	{GameScript::PickLockFailed, trigger_picklockfailed},
+	{GameScript::PickpocketFailed, trigger_pickpocketfailed},
+	{GameScript::ReceivedOrder, trigger_receivedorder},
+	{GameScript::SpellCast, trigger_spellcast},
+	{GameScript::SpellCastInnate, trigger_spellcastinnate},
+	{GameScript::SpellCastOnMe, trigger_spellcastonme},
+	{GameScript::SpellCastPriest, trigger_spellcastpriest},
+	{GameScript::StealFailed, trigger_disarmfailed},
+	{GameScript::TookDamage, trigger_tookdamage},
+	{GameScript::TrapTriggered, trigger_traptriggered},
+	{GameScript::TriggerTrigger, trigger_trigger},
+	{GameScript::TurnedBy, trigger_turnedby},
+	{GameScript::Unlocked, trigger_unlocked},
+	{GameScript::WalkedToTrigger, trigger_walkedtotrigger},
+	{GameScript::WasInDialog, trigger_wasindialog},
+	{ NULL,0}
+};
+
+//the event each trigger code matches against, 0 if it isn't a pure event
+static unsigned short triggerEvent[MAX_TRIGGERS];
+//how many trigger evaluations were answered by the event mask alone
+static unsigned long eventMaskRejects = 0;
+static unsigned long eventMaskChecks = 0;
+
 static const IDSLink idsnames[] = {
 	{"align", GameScript::ID_Alignment},
 	{"alignmen", GameScript::ID_Alignment},
@@ -1332,9 +1392,39 @@ void Targets::dump() const
 	}
 }
 
+// runtime generated actions and triggers are mostly the same few strings
+// (dialog, cutscenes, action overrides), so the parsed forms are kept and
+// handed out as copies. Strings built with changing numbers would make this
+// grow without bounds, so it is simply emptied when it gets too big.
+#define MAX_PARSE_CACHE 1024
+
+typedef std::map<std::string, Action*> ActionCache;
+typedef std::map<std::string, Trigger*> TriggerCache;
+static ActionCache actionCache;
+static TriggerCache triggerCache;
+
+static void ClearParseCache()
+{
+	ActionCache::iterator a;
+	for (a = actionCache.begin(); a != actionCache.end(); ++a) {
+		a->second->Release();
+	}
+	actionCache.clear();
+	TriggerCache::iterator t;
+	for (t = triggerCache.begin(); t != triggerCache.end(); ++t) {
+		t->second->Release();
+	}
+	triggerCache.clear();
+}
+
 /** releasing global memory */
 static void CleanupIEScript()
 {
+	ClearParseCache();
+	if (eventMaskChecks) {
+		Log(DEBUG, "GameScript", "Event triggers rejected by mask: %lu of %lu",
+			eventMaskRejects, eventMaskChecks);
+	}
 	triggersTable.release();
 	actionsTable.release();
 	objectsTable.release();
@@ -1779,6 +1869,21 @@ void InitializeIEScript()
 			triggerflags[i] |= TF_SAVED;
 		}
 	}
+
+	// remember which trigger codes only look up a queued event, so they
+	// can be rejected without walking the trigger list of the sender
+	memset( triggerEvent, 0, sizeof( triggerEvent ) );
+	for (i = 0; i < MAX_TRIGGERS; i++) {
+		if (!triggers[i]) {
+			continue;
+		}
+		for (j = 0; triggerevents[j].Function; j++) {
+			if (triggers[i] == triggerevents[j].Function) {
+				triggerEvent[i] = triggerevents[j].Event;
+				break;
+			}
+		}
+	}
 }
 
 /********************** GameScript *******************************/
@@ -2272,20 +2377,30 @@ int Trigger::Evaluate(Scriptable* Sender)
 		return 0;
 	}
 	TriggerFunction func = triggers[triggerID];
-	const char *tmpstr=triggersTable->GetValue(triggerID);
-	if (!tmpstr) {
-		tmpstr=triggersTable->GetValue(triggerID|0x4000);
-	}
-	if (!func) {
-		triggers[triggerID] = GameScript::False;
-		Log(WARNING, "GameScript", "Unhandled trigger code: 0x%04x %s",
-			triggerID, tmpstr );
-		return 0;
-	}
-	if (InDebug&ID_TRIGGERS) {
+	// the name is only needed for the messages
+	if (!func || (InDebug&ID_TRIGGERS)) {
+		const char *tmpstr=triggersTable->GetValue(triggerID);
+		if (!tmpstr) {
+			tmpstr=triggersTable->GetValue(triggerID|0x4000);
+		}
+		if (!func) {
+			triggers[triggerID] = GameScript::False;
+			Log(WARNING, "GameScript", "Unhandled trigger code: 0x%04x %s",
+				triggerID, tmpstr );
+			return 0;
+		}
 		Log(WARNING, "GameScript", "Executing trigger code: 0x%04x %s",
 				triggerID, tmpstr );
 	}
+	// the sender has no such event queued, so it can't match
+	unsigned short event = triggerEvent[triggerID];
+	if (event) {
+		eventMaskChecks++;
+		if (!Sender->HasTrigger(event)) {
+			eventMaskRejects++;
+			return (flags & TF_NEGATE) ? 1 : 0;
+		}
+	}
 	int ret = func( Sender, this );
 	if (flags & TF_NEGATE) {
 		return !ret;
@@ -2452,12 +2567,8 @@ void GameScript::ExecuteAction(Scriptable* Sender, Action* aC)
 	}
 }
 
-Trigger* GenerateTrigger(char* String)
+static Trigger* GenerateTriggerUncached(char* String)
 {
-	strlwr( String );
-	if (InDebug&ID_TRIGGERS) {
-		Log(WARNING, "GameScript", "Compiling:%s", String);
-	}
 	int negate = 0;
 	if (*String == '!') {
 		String++;
@@ -2479,15 +2590,34 @@ Trigger* GenerateTrigger(char* String)
 	return trigger;
 }
 
-Action* GenerateAction(const char* String)
+Trigger* GenerateTrigger(char* String)
+{
+	strlwr( String );
+	if (InDebug&ID_TRIGGERS) {
+		Log(WARNING, "GameScript", "Compiling:%s", String);
+	}
+	std::string key(String);
+	TriggerCache::iterator it = triggerCache.find(key);
+	if (it != triggerCache.end()) {
+		return TriggerCopy(it->second);
+	}
+	Trigger *trigger = GenerateTriggerUncached(String);
+	if (!trigger) {
+		return NULL;
+	}
+	if (triggerCache.size() >= MAX_PARSE_CACHE) {
+		ClearParseCache();
+	}
+	triggerCache[key] = TriggerCopy(trigger);
+	return trigger;
+}
+
+static Action* GenerateActionUncached(const char* String)
 {
 	Action* action = NULL;
 	char* actionString = strdup(String);
 	// the only thing we seem to need a copy for is the call to strlwr...
 	strlwr( actionString );
-	if (InDebug&ID_ACTIONS) {
-		Log(WARNING, "GameScript", "Compiling:%s", String);
-	}
 	int len = strlench(String,'(')+1; //including (
 	char *src = actionString+len;
 	int i = -1;
@@ -2519,6 +2649,29 @@ Action* GenerateAction(const char* String)
 	return action;
 }
 
+Action* GenerateAction(const char* String)
+{
+	if (InDebug&ID_ACTIONS) {
+		Log(WARNING, "GameScript", "Compiling:%s", String);
+	}
+	std::string key(String);
+	ActionCache::iterator it = actionCache.find(key);
+	if (it != actionCache.end()) {
+		return ParamCopy(it->second);
+	}
+	Action *action = GenerateActionUncached(String);
+	if (!action) {
+		return NULL;
+	}
+	if (actionCache.size() >= MAX_PARSE_CACHE) {
+		ClearParseCache();
+	}
+	Action *cached = ParamCopy(action);
+	cached->IncRef();
+	actionCache[key] = cached;
+	return action;
+}
+
 Action* GenerateActionDirect(const char *String, Scriptable *object)
 {
 	Action* action = GenerateAction(String);
@@ -190,23 +190,29 @@ bool GlobalTimer::Update()
 	if (!map) {
 		goto end;
 	}
+	UpdateWorld(game, map, gc->GetDialogueFlags()&DF_IN_DIALOG, thisTime != 0);
+end:
+	startTime = thisTime;
+	return true;
+}
+
+void GlobalTimer::UpdateWorld(Game *game, Map *map, bool inDialog, bool advanceClock)
+{
 	//do spell effects expire in dialogs?
 	//if yes, then we should remove this condition
-	if (!(gc->GetDialogueFlags()&DF_IN_DIALOG) ) {
+	if (!inDialog) {
 		map->UpdateFog();
 		map->UpdateEffects();
-		if (thisTime) {
+		map->UpdateProjectiles();
+		if (advanceClock) {
 			//this measures in-world time (affected by effects, actions, etc)
 			game->AdvanceTime(1);
 		}
 	}
 	//this measures time spent in the game (including pauses)
-	if (thisTime) {
+	if (advanceClock) {
 		game->RealTime++;
 	}
-end:
-	startTime = thisTime;
-	return true;
 }
 
 
@@ -30,6 +30,8 @@
 namespace GemRB {
 
 class ControlAnimation;
+class Game;
+class Map;
 
 struct AnimationRef
 {
@@ -64,6 +66,8 @@ public:
 	void Init();
 	void Freeze();
 	bool Update();
+	/** the in-world part of Update: one tick of the current area and the game clock */
+	void UpdateWorld(Game *game, Map *map, bool inDialog, bool advanceClock);
 	bool ViewportIsMoving();
 	void DoStep(int count);
 	void SetMoveViewPort(ieDword x, ieDword y, int spd, bool center);
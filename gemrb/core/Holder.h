@@ -28,18 +28,38 @@
 #include <iostream>
 #endif
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace GemRB {
 
+// the reference counts are atomic where the compiler provides the means, so
+// held objects (plugins, resources, sound handles) can be shared with threads
+#if defined(__GNUC__)
+typedef size_t HeldCount;
+#define HELD_INCREMENT(count) __sync_add_and_fetch(&(count), 1)
+#define HELD_DECREMENT(count) __sync_sub_and_fetch(&(count), 1)
+#elif defined(_MSC_VER)
+typedef long HeldCount;
+#define HELD_INCREMENT(count) _InterlockedIncrement(&(count))
+#define HELD_DECREMENT(count) _InterlockedDecrement(&(count))
+#else
+typedef size_t HeldCount;
+#define HELD_INCREMENT(count) (++(count))
+#define HELD_DECREMENT(count) (--(count))
+#endif
+
 template <class T>
 class Held {
 public:
 	Held() : RefCount(0) {}
-	void acquire() { ++RefCount; }
+	void acquire() { HELD_INCREMENT(RefCount); }
 	void release() { assert(RefCount && "Broken Held usage.");
-		if (!--RefCount) delete static_cast<T*>(this); }
-	size_t GetRefCount() { return RefCount; }
+		if (!HELD_DECREMENT(RefCount)) delete static_cast<T*>(this); }
+	size_t GetRefCount() { return (size_t) RefCount; }
 private:
-	size_t RefCount;
+	volatile HeldCount RefCount;
 };
 
 /**
@@ -43,6 +43,7 @@
 #include "EffectMgr.h"
 #include "EffectQueue.h"
 #include "Factory.h"
+#include "FileCache.h"
 #include "FontManager.h"
 #include "Game.h"
 #include "GameData.h"
@@ -195,11 +196,15 @@ Interface::Interface()
 	TouchScrollAreas = false;
 	UseSoftKeyboard = false;
 	KeepCache = false;
+	CacheSize = 1024;
 	NumFingInfo = 2;
 	NumFingKboard = 3;
 	NumFingScroll = 2;
 	MouseFeedback = 0;
 	TooltipDelay = 100;
+	ScriptBudget = 10;
+	BenchmarkTicks = 0;
+	BenchmarkHashInterval = 0;
 	IgnoreOriginalINI = 0;
 	Bpp = 32;
 	GUIScriptsPath[0] = 0;
@@ -606,6 +611,14 @@ void Interface::HandleEvents()
 	}
 }
 
+// in benchmark mode, logs how long a load or save stage took since the previous one
+static void BenchmarkStage(const char *stage, unsigned __int64 &since)
+{
+	unsigned __int64 now = GetMicroTicks();
+	Log(MESSAGE, "Benchmark", "%s: %.1fms", stage, (now - since) / 1000.0);
+	since = now;
+}
+
 /* handle main loop events that might destroy or create windows
 thus cannot be called from DrawWindows directly
 */
@@ -634,6 +647,7 @@ void Interface::HandleFlags()
 			EventFlag|=EF_EXPANSION;
 			timer->Init();
 
+			unsigned __int64 enterStart = GetMicroTicks();
 			GameControl* gc = StartGameControl();
 
 			//switch map to protagonist
@@ -641,6 +655,9 @@ void Interface::HandleFlags()
 			if (actor) {
 				gc->ChangeMap(actor, true);
 			}
+			if (BenchmarkTicks) {
+				BenchmarkStage("Entering the game (area load)", enterStart);
+			}
 
 			//rearrange party slots
 			game->ConsolidateParty();
@@ -654,6 +671,18 @@ void Interface::HandleFlags()
 		QuitFlag &= ~QF_CHANGESCRIPT;
 		guiscript->LoadScript( NextScript );
 		guiscript->RunFunction( NextScript, "OnLoad" );
+
+		// go straight from the start screen into the benchmarked save
+		if (!BenchmarkSave.empty()) {
+			Holder<SaveGame> sg = sgiterator->GetSaveGame(BenchmarkSave.c_str());
+			if (sg) {
+				SetupLoadGame(sg, 0);
+				QuitFlag |= QF_ENTERGAME;
+			} else {
+				Log(ERROR, "Benchmark", "Save game \"%s\" not found!", BenchmarkSave.c_str());
+			}
+			BenchmarkSave.clear();
+		}
 	}
 }
 
@@ -1253,8 +1282,33 @@ int Interface::LoadFonts()
 	return GEM_OK;
 }
 
+// Init is split into stages by their log messages, each timed until the next starts
+static const char *currentStage = NULL;
+static unsigned long stageStart = 0;
+static const char *slowestStage = "none";
+static unsigned long slowestStageTime = 0;
+
+static void InitStage(const char *stage)
+{
+	unsigned long now = GetTickCount();
+	if (currentStage) {
+		unsigned long elapsed = now - stageStart;
+		Log(DEBUG, "Core", "%s took %lums", currentStage, elapsed);
+		if (elapsed > slowestStageTime) {
+			slowestStage = currentStage;
+			slowestStageTime = elapsed;
+		}
+	}
+	if (stage) {
+		Log(MESSAGE, "Core", "%s...", stage);
+	}
+	currentStage = stage;
+	stageStart = now;
+}
+
 int Interface::Init(InterfaceConfig* config)
 {
+	unsigned long initStart = GetTickCount();
 	if (!config) {
 		Log(FATAL, "Core", "No Configuration context.");
 		return GEM_ERROR;
@@ -1263,7 +1317,7 @@ int Interface::Init(InterfaceConfig* config)
 	plugin_flags = new Variables();
 	plugin_flags->SetType( GEM_VARIABLES_INT );
 
-	Log(MESSAGE, "Core", "Initializing the Event Manager...");
+	InitStage("Initializing the Event Manager");
 	evntmgr = new EventMgr();
 
 	lists = new Variables();
@@ -1281,6 +1335,7 @@ int Interface::Init(InterfaceConfig* config)
 	vars->SetType( GEM_VARIABLES_INT );
 	vars->ParseKey(true);
 
+	InitStage("Reading the configuration");
 	const char* value = NULL;
 #define CONFIG_INT(key, var) \
 		value = config->GetValueForKey(key); \
@@ -1288,7 +1343,10 @@ int Interface::Init(InterfaceConfig* config)
 			var ( atoi( value ) ); \
 		value = NULL;
 
+	CONFIG_INT("BenchmarkHashInterval", BenchmarkHashInterval = );
+	CONFIG_INT("BenchmarkTicks", BenchmarkTicks = );
 	CONFIG_INT("Bpp", Bpp =);
+	CONFIG_INT("CacheSize", CacheSize =);
 	vars->SetAt("BitsPerPixel", Bpp); //put into vars so that reading from game.ini wont overwrite
 	CONFIG_INT("CaseSensitive", CaseSensitive =);
 	CONFIG_INT("DoubleClickDelay", evntmgr->SetDCDelay);
@@ -1306,8 +1364,10 @@ int Interface::Init(InterfaceConfig* config)
 	CONFIG_INT("MaxPartySize", MaxPartySize = );
 	vars->SetAt("MaxPartySize", MaxPartySize); // for simple GUIScript access
 	CONFIG_INT("MultipleQuickSaves", MultipleQuickSaves = );
+	CONFIG_INT("RandomSeed", RNG_SFMT::getInstance()->seed);
 	CONFIG_INT("RepeatKeyDelay", evntmgr->SetRKDelay);
 	CONFIG_INT("SaveAsOriginal", SaveAsOriginal = );
+	CONFIG_INT("ScriptBudget", ScriptBudget = );
 	CONFIG_INT("ScriptDebugMode", SetScriptDebugMode);
 	CONFIG_INT("SkipIntroVideos", SkipIntroVideos = );
 	CONFIG_INT("TooltipDelay", TooltipDelay = );
@@ -1391,6 +1451,7 @@ int Interface::Init(InterfaceConfig* config)
 		value = NULL;
 
 	CONFIG_STRING("AudioDriver", AudioDriverName);
+	CONFIG_STRING("BenchmarkSave", BenchmarkSave);
 	CONFIG_STRING("VideoDriver", VideoDriverName);
 	CONFIG_STRING("Encoding", Encoding);
 #undef CONFIG_STRING
@@ -1435,6 +1496,7 @@ int Interface::Init(InterfaceConfig* config)
 		}
 	}
 
+	InitStage("Setting up the cache");
 	if (!MakeDirectories(CachePath)) {
 		error("Core", "Unable to create cache directory '%s'", CachePath);
 	}
@@ -1443,9 +1505,10 @@ int Interface::Init(InterfaceConfig* config)
 		Log(ERROR, "Core", "Cache path %s doesn't exist, not a folder or contains alien files!", CachePath );
 		return false;
 	}
-	if (!KeepCache) DelTree((const char *) CachePath, false);
+	// decompressed archives are kept as long as they match their source
+	if (!KeepCache) PruneCache(CacheSize);
 
-	Log(MESSAGE, "Core", "Starting Plugin Manager...");
+	InitStage("Starting Plugin Manager");
 	PluginMgr *plugin = PluginMgr::Get();
 #if TARGET_OS_MAC
 	// search the bundle plugins first
@@ -1458,15 +1521,15 @@ int Interface::Init(InterfaceConfig* config)
 #endif
 	LoadPlugins(PluginsPath);
 	if (plugin && plugin->GetPluginCount()) {
-		Log(MESSAGE, "Core", "Plugin Loading Complete...");
+		InitStage("Plugin Loading Complete");
 	} else {
 		Log(FATAL, "Core", "Plugin Loading Failed, check path...");
 		return GEM_ERROR;
 	}
 	plugin->RunInitializers();
 
-	Log(MESSAGE, "Core", "GemRB Core Initialization...");
-	Log(MESSAGE, "Core", "Initializing Video Driver...");
+	InitStage("GemRB Core Initialization");
+	InitStage("Initializing Video Driver");
 	video = ( Video * ) PluginMgr::Get()->GetDriver(&Video::ID, VideoDriverName.c_str());
 	if (!video) {
 		Log(FATAL, "Core", "No Video Driver Available.");
@@ -1494,7 +1557,7 @@ int Interface::Init(InterfaceConfig* config)
 	SetInfoTextColor(defcolor);
 
 	{
-		Log(MESSAGE, "Core", "Initializing Search Path...");
+		InitStage("Initializing Search Path");
 		if (!IsAvailable( PLUGIN_RESOURCE_DIRECTORY )) {
 			Log(FATAL, "Core", "no DirectoryImporter!");
 			return GEM_ERROR;
@@ -1566,7 +1629,7 @@ int Interface::Init(InterfaceConfig* config)
 	}
 
 	{
-		Log(MESSAGE, "Core", "Initializing KEY Importer...");
+		InitStage("Initializing KEY Importer");
 		char ChitinPath[_MAX_PATH];
 		PathJoin( ChitinPath, GamePath, "chitin.key", NULL );
 		if (!gamedata->AddSource(ChitinPath, "chitin.key", PLUGIN_RESOURCE_KEY)) {
@@ -1575,7 +1638,7 @@ int Interface::Init(InterfaceConfig* config)
 		}
 	}
 
-	Log(MESSAGE, "Core", "Initializing GUI Script Engine...");
+	InitStage("Initializing GUI Script Engine");
 	guiscript = PluginHolder<ScriptEngine>(IE_GUI_SCRIPT_CLASS_ID);
 	if (guiscript == NULL) {
 		Log(FATAL, "Core", "Missing GUI Script Engine.");
@@ -1599,7 +1662,7 @@ int Interface::Init(InterfaceConfig* config)
 	// Purposely add the font directory last since we will only ever need it at engine load time.
 	if (CustomFontPath[0]) gamedata->AddSource(CustomFontPath, "CustomFonts", PLUGIN_RESOURCE_DIRECTORY);
 
-	Log(MESSAGE, "Core", "Reading Game Options...");
+	InitStage("Reading Game Options");
 	if (!LoadGemRBINI()) {
 		Log(FATAL, "Core", "Cannot Load INI.");
 		return GEM_ERROR;
@@ -1638,24 +1701,24 @@ int Interface::Init(InterfaceConfig* config)
 	}
 	GameNameResRef[i] = 0;
 
-	Log(MESSAGE, "Core", "Reading Encoding Table...");
+	InitStage("Reading Encoding Table");
 	if (!LoadEncoding()) {
 		Log(ERROR, "Core", "Cannot Load Encoding.");
 	}
 
-	Log(MESSAGE, "Core", "Creating Projectile Server...");
+	InitStage("Creating Projectile Server");
 	projserv = new ProjectileServer();
 	if (!projserv->GetHighestProjectileNumber()) {
 		Log(ERROR, "Core", "No projectiles are available...");
 	}
 
-	Log(MESSAGE, "Core", "Checking for Dialogue Manager...");
+	InitStage("Checking for Dialogue Manager");
 	if (!IsAvailable( IE_TLK_CLASS_ID )) {
 		Log(FATAL, "Core", "No TLK Importer Available.");
 		return GEM_ERROR;
 	}
 	strings = PluginHolder<StringMgr>(IE_TLK_CLASS_ID);
-	Log(MESSAGE, "Core", "Loading Dialog.tlk file...");
+	InitStage("Loading Dialog.tlk file");
 	char strpath[_MAX_PATH];
 	PathJoin(strpath, GamePath, "dialog.tlk", NULL);
 	FileStream* fs = FileStream::OpenFile(strpath);
@@ -1668,7 +1731,7 @@ int Interface::Init(InterfaceConfig* config)
 	// does the language use an extra tlk?
 	if (strings->HasAltTLK()) {
 		strings2 = PluginHolder<StringMgr>(IE_TLK_CLASS_ID);
-		Log(MESSAGE, "Core", "Loading DialogF.tlk file...");
+		InitStage("Loading DialogF.tlk file");
 		char strpath[_MAX_PATH];
 		PathJoin(strpath, GamePath, "dialogf.tlk", NULL);
 		FileStream* fs = FileStream::OpenFile(strpath);
@@ -1682,7 +1745,7 @@ int Interface::Init(InterfaceConfig* config)
 	}
 
 	{
-		Log(MESSAGE, "Core", "Loading Palettes...");
+		InitStage("Loading Palettes");
 		ResourceHolder<ImageMgr> pal16im(Palette16);
 		if (pal16im)
 			pal16 = pal16im->GetImage();
@@ -1704,16 +1767,16 @@ int Interface::Init(InterfaceConfig* config)
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Initializing stock sounds...");
+	InitStage("Initializing stock sounds");
 	DSCount = ReadResRefTable ("defsound", DefSound);
 	if (DSCount == 0) {
 		Log(FATAL, "Core", "Cannot find defsound.2da.");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Broadcasting Event Manager...");
+	InitStage("Broadcasting Event Manager");
 	video->SetEventMgr( evntmgr );
-	Log(MESSAGE, "Core", "Initializing Window Manager...");
+	InitStage("Initializing Window Manager");
 	windowmgr = PluginHolder<WindowMgr>(IE_CHU_CLASS_ID);
 	if (windowmgr == NULL) {
 		Log(FATAL, "Core", "Failed to load Window Manager.");
@@ -1728,7 +1791,7 @@ int Interface::Init(InterfaceConfig* config)
 
 	QuitFlag = QF_CHANGESCRIPT;
 
-	Log(MESSAGE, "Core", "Starting up the Sound Driver...");
+	InitStage("Starting up the Sound Driver");
 	AudioDriver = ( Audio * ) PluginMgr::Get()->GetDriver(&Audio::ID, AudioDriverName.c_str());
 	if (AudioDriver == NULL) {
 		Log(FATAL, "Core", "Failed to load sound driver.");
@@ -1739,7 +1802,7 @@ int Interface::Init(InterfaceConfig* config)
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Allocating SaveGameIterator...");
+	InitStage("Allocating SaveGameIterator");
 	sgiterator = new SaveGameIterator();
 	if (sgiterator == NULL) {
 		Log(FATAL, "Core", "Failed to allocate SaveGameIterator.");
@@ -1751,7 +1814,7 @@ int Interface::Init(InterfaceConfig* config)
 	vars->SetAt( "GUIEnhancements", (unsigned long)GUIEnhancements );
 	vars->SetAt( "TouchScrollAreas", (unsigned long)TouchScrollAreas );
 
-	Log(MESSAGE, "Core", "Initializing Token Dictionary...");
+	InitStage("Initializing Token Dictionary");
 	tokens = new Variables();
 	if (!tokens) {
 		Log(FATAL, "Core", "Failed to allocate Token dictionary.");
@@ -1759,14 +1822,14 @@ int Interface::Init(InterfaceConfig* config)
 	}
 	tokens->SetType( GEM_VARIABLES_STRING );
 
-	Log(MESSAGE, "Core", "Initializing Music Manager...");
+	InitStage("Initializing Music Manager");
 	music = PluginHolder<MusicMgr>(IE_MUS_CLASS_ID);
 	if (!music) {
 		Log(FATAL, "Core", "Failed to load Music Manager.");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Loading music list...");
+	InitStage("Loading music list");
 	if (HasFeature( GF_HAS_SONGLIST )) {
 		ret = ReadMusicTable("songlist", 1);
 	} else {
@@ -1781,7 +1844,7 @@ int Interface::Init(InterfaceConfig* config)
 
 	int resdata = HasFeature( GF_RESDATA_INI );
 	if (resdata || HasFeature(GF_SOUNDS_INI) ) {
-		Log(MESSAGE, "Core", "Loading resource data File...");
+		InitStage("Loading resource data File");
 		INIresdata = PluginHolder<DataFileMgr>(IE_INI_CLASS_ID);
 		DataStream* ds = gamedata->GetResource(resdata? "resdata":"sounds", IE_INI_CLASS_ID);
 		if (!INIresdata->Open(ds)) {
@@ -1790,7 +1853,7 @@ int Interface::Init(InterfaceConfig* config)
 	}
 
 	if (HasFeature( GF_HAS_PARTY_INI )) {
-		Log(MESSAGE, "Core", "Loading precreated teams setup...");
+		InitStage("Loading precreated teams setup");
 		INIparty = PluginHolder<DataFileMgr>(IE_INI_CLASS_ID);
 		char tINIparty[_MAX_PATH];
 		PathJoin( tINIparty, GamePath, "Party.ini", NULL );
@@ -1805,7 +1868,7 @@ int Interface::Init(InterfaceConfig* config)
 	}
 
 	if (HasFeature( GF_HAS_BEASTS_INI )) {
-		Log(MESSAGE, "Core", "Loading beasts definition File...");
+		InitStage("Loading beasts definition File");
 		INIbeasts = PluginHolder<DataFileMgr>(IE_INI_CLASS_ID);
 		char tINIbeasts[_MAX_PATH];
 		PathJoin( tINIbeasts, GamePath, "beast.ini", NULL );
@@ -1815,7 +1878,7 @@ int Interface::Init(InterfaceConfig* config)
 			Log(WARNING, "Core", "Failed to load beast definitions.");
 		}
 
-		Log(MESSAGE, "Core", "Loading quests definition File...");
+		InitStage("Loading quests definition File");
 		INIquests = PluginHolder<DataFileMgr>(IE_INI_CLASS_ID);
 		char tINIquests[_MAX_PATH];
 		PathJoin( tINIquests, GamePath, "quests.ini", NULL );
@@ -1829,97 +1892,97 @@ int Interface::Init(InterfaceConfig* config)
 	calendar = NULL;
 	keymap = NULL;
 
-	Log(MESSAGE, "Core", "Bringing up the Global Timer...");
+	InitStage("Bringing up the Global Timer");
 	timer = new GlobalTimer();
 	if (!timer) {
 		Log(FATAL, "Core", "Failed to create global timer.");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Initializing effects...");
+	InitStage("Initializing effects");
 	ret = Init_EffectQueue();
 	if (!ret) {
 		Log(FATAL, "Core", "Failed to initialize effects.");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Initializing Inventory Management...");
+	InitStage("Initializing Inventory Management");
 	ret = InitItemTypes();
 	if (!ret) {
 		Log(FATAL, "Core", "Failed to initialize inventory.");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Initializing string constants...");
+	InitStage("Initializing string constants");
 	displaymsg = new DisplayMessage();
 	if (!displaymsg) {
 		Log(FATAL, "Core", "Failed to initialize string constants.");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Initializing random treasure...");
+	InitStage("Initializing random treasure");
 	ret = ReadRandomItems();
 	if (!ret) {
 		Log(WARNING, "Core", "Failed to initialize random treasure.");
 	}
 
-	Log(MESSAGE, "Core", "Initializing ability tables...");
+	InitStage("Initializing ability tables");
 	ret = ReadAbilityTables();
 	if (!ret) {
 		Log(FATAL, "Core", "Failed to initialize ability tables...");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Reading reputation mod table...");
+	InitStage("Reading reputation mod table");
 	ret = ReadReputationModTable();
 	if (!ret) {
 		Log(WARNING, "Core", "Failed to read reputation mod table.");
 	}
 
 	if ( gamedata->Exists("WMAPLAY", IE_2DA_CLASS_ID) ) {
-		Log(MESSAGE, "Core", "Initializing area aliases...");
+		InitStage("Initializing area aliases");
 		ret = ReadAreaAliasTable( "WMAPLAY" );
 		if (!ret) {
 			Log(WARNING, "Core", "Failed to load area aliases...");
 		}
 	}
 
-	Log(MESSAGE, "Core", "Reading game time table...");
+	InitStage("Reading game time table");
 	ret = ReadGameTimeTable();
 	if (!ret) {
 		Log(FATAL, "Core", "Failed to read game time table...");
 		return GEM_ERROR;
 	}
 
-	Log(MESSAGE, "Core", "Reading special spells table...");
+	InitStage("Reading special spells table");
 	ret = ReadSpecialSpells();
 	if (!ret) {
 		Log(WARNING, "Core", "Failed to load special spells.");
 	}
 
+	InitStage("Reading damage type table");
 	ret = ReadDamageTypeTable();
-	Log(MESSAGE, "Core", "Reading damage type table...");
 	if (!ret) {
 		Log(WARNING, "Core", "Reading damage type table...");
 	}
 
-	Log(MESSAGE, "Core", "Reading modal states table...");
+	InitStage("Reading modal states table");
 	ret = ReadModalStates();
 	if (!ret) {
 		Log(ERROR, "Core", "Failed to modal states table...");
 	}
 
-	Log(MESSAGE, "Core", "Reading game script tables...");
+	InitStage("Reading game script tables");
 	InitializeIEScript();
 
-	Log(MESSAGE, "Core", "Initializing keymap tables...");
+	InitStage("Initializing keymap tables");
 	keymap = new KeyMap();
 	ret = keymap->InitializeKeyMap("keymap.ini", "keymap");
 	if (!ret) {
 		Log(WARNING, "Core", "Failed to initialize keymaps.");
 	}
 
-	Log(MESSAGE, "Core", "Setting up the Console...");
+	InitStage("Setting up the Console");
 	console = new Console(Region(0, 0, Width, 25));
 	Sprite2D* cursor = GetCursorSprite();
 	if (!cursor) {
@@ -1927,7 +1990,9 @@ int Interface::Init(InterfaceConfig* config)
 	} else
 		console->SetCursor (cursor);
 
-	Log(MESSAGE, "Core", "Core Initialization Complete!");
+	InitStage(NULL);
+	Log(MESSAGE, "Core", "Core Initialization Complete! (%lums, slowest: %s with %lums)",
+		GetTickCount() - initStart, slowestStage, slowestStageTime);
 	return GEM_OK;
 }
 
@@ -2962,6 +3027,11 @@ void Interface::GameLoop(void)
 		update_scripts = !(gc->GetDialogueFlags() & DF_FREEZE_SCRIPTS);
 	}
 
+	if (BenchmarkTicks && gc && game && game->GetCurrentArea()) {
+		RunBenchmark();
+		return;
+	}
+
 	bool do_update = GSUpdate(update_scripts);
 
 	if (game) {
@@ -2976,6 +3046,68 @@ void Interface::GameLoop(void)
 	}
 }
 
+void Interface::RunBenchmark()
+{
+	// the budget depends on the wall clock and would make runs diverge
+	ScriptBudget = 0;
+	Log(MESSAGE, "Benchmark", "Running %u ticks, starting in %s", BenchmarkTicks,
+		game->GetCurrentArea()->GetScriptName());
+
+	// in microseconds, single phases of a tick rarely take a whole millisecond
+	unsigned __int64 worldTime = 0, scriptTime = 0, moveTime = 0, triggerTime = 0;
+	unsigned __int64 start = GetMicroTicks();
+	unsigned int tick;
+	for (tick = 1; tick <= BenchmarkTicks; tick++) {
+		Map *map = game->GetCurrentArea();
+		if (!map) {
+			Log(ERROR, "Benchmark", "Lost the current area at tick %u!", tick);
+			break;
+		}
+
+		unsigned __int64 tickStart = GetMicroTicks();
+		GameControl *gc = GetGameControl();
+		timer->UpdateWorld(game, map, gc && (gc->GetDialogueFlags()&DF_IN_DIALOG), true);
+		worldTime += GetMicroTicks() - tickStart;
+
+		game->UpdateScripts();
+		for (size_t i = 0; i < game->GetLoadedMapCount(); i++) {
+			map = game->GetMap(i);
+			scriptTime += map->ScriptTime;
+			moveTime += map->MoveTime;
+			triggerTime += map->TriggerTime;
+		}
+
+		if (BenchmarkHashInterval && !(tick % BenchmarkHashInterval)) {
+			Log(MESSAGE, "Benchmark", "Tick %u state hash: %08x", tick, game->GetStateHash());
+		}
+	}
+	tick--;
+
+	unsigned __int64 total = GetMicroTicks() - start;
+	unsigned __int64 measured = worldTime + scriptTime + moveTime + triggerTime;
+	Log(MESSAGE, "Benchmark", "%u ticks in %.1fms (%.1f ticks/s)", tick, total / 1000.0,
+		total ? tick * 1000000.0 / total : 0.0);
+	Log(MESSAGE, "Benchmark", "World: %.1fms, actor scripts: %.1fms, movement: %.1fms, triggers: %.1fms, other: %.1fms",
+		worldTime / 1000.0, scriptTime / 1000.0, moveTime / 1000.0, triggerTime / 1000.0,
+		total > measured ? (total - measured) / 1000.0 : 0.0);
+	Log(MESSAGE, "Benchmark", "Final state hash: %08x", game->GetStateHash());
+
+	// the save path up to the archive, written to the cache only
+	unsigned __int64 saveStart = GetMicroTicks();
+	size_t mc = game->GetLoadedMapCount();
+	while (mc--) {
+		SwapoutArea(game->GetMap(mc));
+	}
+	BenchmarkStage("Saving the areas", saveStart);
+	WriteGame(CachePath);
+	BenchmarkStage("Saving the game and its variables", saveStart);
+	// don't let a later new game pick it up from the cache
+	RemoveFromCache(GameNameResRef, IE_GAM_CLASS_ID);
+
+	BenchmarkTicks = 0;
+	ExitGemRB();
+}
+
 /** handles hardcoded gui behaviour */
 void Interface::HandleGUIBehaviour(void)
 {
@@ -3797,6 +3929,7 @@ void Interface::LoadGame(SaveGame *sg, int ver_override)
 	LoadProgress(10);
 	if (!KeepCache) DelTree((const char *) CachePath, true);
 	LoadProgress(15);
+	unsigned __int64 stageStart = GetMicroTicks();
 
 	if (sg == NULL) {
 		//Load the Default Game
@@ -3838,6 +3971,9 @@ void Interface::LoadGame(SaveGame *sg, int ver_override)
 		goto cleanup;
 
 	gam_str = NULL;
+	if (BenchmarkTicks) {
+		BenchmarkStage("Loading the game and its variables", stageStart);
+	}
 
 	// Load WMP (WorldMap) file
 	if (!wmp_mgr)
@@ -3850,6 +3986,9 @@ void Interface::LoadGame(SaveGame *sg, int ver_override)
 
 	wmp_str1 = NULL;
 	wmp_str2 = NULL;
+	if (BenchmarkTicks) {
+		BenchmarkStage("Loading the world map", stageStart);
+	}
 
 	LoadProgress(20);
 	// Unpack SAV (archive) file to Cache dir
@@ -3862,6 +4001,9 @@ void Interface::LoadGame(SaveGame *sg, int ver_override)
 		}
 		delete sav_str;
 		sav_str = NULL;
+		if (BenchmarkTicks) {
+			BenchmarkStage("Unpacking the save archive", stageStart);
+		}
 	}
 
 	// Let's assume that now is everything loaded OK and swap the objects
@@ -5067,7 +5209,8 @@ int Interface::SwapoutArea(Map *map)
 
 		str.Create( map->GetScriptName(), IE_ARE_CLASS_ID );
 		int ret = mm->PutArea (&str, map);
-		if (ret <0) {
+		// writes are buffered, so a full disk may only show up here
+		if (ret <0 || !str.Close()) {
 			Log(WARNING, "Core", "Area removed: %s",
 				map->GetScriptName());
 			RemoveFromCache(map->GetScriptName(), IE_ARE_CLASS_ID);
@@ -5099,7 +5242,8 @@ int Interface::WriteCharacter(const char *name, Actor *actor)
 		FileStream str;
 
 		if (!str.Create( Path, name, IE_CHR_CLASS_ID )
-			|| (gm->PutActor(&str, actor, true) < 0)) {
+			|| (gm->PutActor(&str, actor, true) < 0)
+			|| !str.Close()) {
 			Log(WARNING, "Core", "Character cannot be saved: %s", name);
 			return -1;
 		}
@@ -5133,7 +5277,7 @@ int Interface::WriteGame(const char *folder)
 
 		str.Create( folder, GameNameResRef, IE_GAM_CLASS_ID );
 		int ret = gm->PutGame (&str, game);
-		if (ret <0) {
+		if (ret <0 || !str.Close()) {
 			Log(WARNING, "Core", "Game cannot be saved: %s", folder);
 			return -1;
 		}
@@ -5177,6 +5321,9 @@ int Interface::WriteWorldMap(const char *folder)
 			str2.Create( folder, WorldMapName[1], IE_WMP_CLASS_ID );
 		}
 		ret = wmm->PutWorldMap (&str1, &str2, worldmap);
+		if (ret >= 0 && (!str1.Close() || !str2.Close())) {
+			ret = -1;
+		}
 	}
 	if (ret <0) {
 		Log(WARNING, "Core", "Internal error, worldmap cannot be saved: %s", folder);
@@ -5222,6 +5369,11 @@ int Interface::CompressSave(const char *folder)
 			dir.Rewind();
 		}
 	}
+	// writes are buffered, so a full disk may only show up here
+	if (!str.Close()) {
+		Log(WARNING, "Core", "Save archive cannot be written: %s", folder);
+		return -1;
+	}
 	return 0;
 }
 
@@ -335,6 +335,7 @@ private:
 	Holder<Audio> AudioDriver;
 	std::string VideoDriverName;
 	std::string AudioDriverName;
+	std::string BenchmarkSave;
 	ProjectileServer * projserv;
 
 	EventMgr * evntmgr;
@@ -781,6 +782,8 @@ private:
 	GameControl* StartGameControl();
 	/** Executes everything (non graphical) in the main game loop */
 	void GameLoop(void);
+	/** Runs BenchmarkTicks game ticks back to back and reports the timings */
+	void RunBenchmark();
 	/** the internal (without cache) part of GetListFrom2DA */
 	ieDword *GetListFrom2DAInternal(const ieResRef resref);
 public:
@@ -809,6 +812,8 @@ public:
 	std::vector<std::string> ModPath;
 	int Width, Height, Bpp;
 	unsigned int TooltipDelay;
+	unsigned int ScriptBudget;
+	unsigned int BenchmarkTicks, BenchmarkHashInterval;
 	int IgnoreOriginalINI;
 	unsigned int FogOfWar;
 	bool CaseSensitive, SkipIntroVideos, DrawFPS;
@@ -818,6 +823,7 @@ public:
 	int GUIEnhancements;
 	int MaxPartySize;
 	bool KeepCache;
+	unsigned long CacheSize;
 	bool MultipleQuickSaves;
 	bool UseCorruptedHack;
 
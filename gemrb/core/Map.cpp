@@ -363,6 +363,10 @@ Map::Map(void)
 	Background = NULL;
 	BgDuration = 0;
 	LastGoCloser = 0;
+	ScriptTime = 0;
+	MoveTime = 0;
+	TriggerTime = 0;
+	ScriptsDeferred = 0;
 	AreaFlags = AreaType = AreaDifficulty = 0;
 	Rain = Snow = Fog = Lightning = DayNight = 0;
 	trackString = trackFlag = trackDiff = 0;
@@ -370,12 +374,19 @@ Map::Map(void)
 	RestHeader.Difficulty = RestHeader.CreatureNum = RestHeader.Maximum = RestHeader.Enabled = 0;
 	RestHeader.DayChance = RestHeader.NightChance = RestHeader.sduration = RestHeader.rwdist = RestHeader.owdist = 0;
 	reverb = NULL;
+	actorIndex.init(257, 64);
+	actorNameGeneration = 0;
 }
 
 Map::~Map(void)
 {
 	unsigned int i;
 
+#ifdef HASHMAP_DEBUG
+	actorIndex.dumpStats("actors by global ID");
+	actorNameIndex.dumpStats("actors by script name");
+#endif
+
 	free( MapSet );
 	free( SrchMap );
 	free( MaterialMap );
@@ -669,6 +680,7 @@ void Map::DrawPortal(InfoPoint *ip, int enable)
 void Map::UpdateScripts()
 {
 	bool has_pcs = false;
+	ScriptTime = MoveTime = TriggerTime = 0;
 	size_t i=actors.size();
 	while (i--) {
 		if (actors[i]->InParty) {
@@ -715,15 +727,34 @@ void Map::UpdateScripts()
 	// below starts a cutscene, hiding the mouse. - wjp, 20060805
 	if (core->GetGameControl()->GetDialogueFlags() & DF_FREEZE_SCRIPTS) return;
 
-	//Run actor scripts (only for 0 priority)
-	int q=Qcount[PR_SCRIPT];
-
 	Game *game = core->GetGame();
 	bool timestop = game->IsTimestopActive();
 	if (!timestop) {
 		game->SetTimestopOwner(NULL);
 	}
 
+	// travel region uses are queued for ResolvePendingExits, but actions
+	// run here (MoveBetweenAreas, JumpToArea...) still move actors across
+	// maps right away
+	UpdateActorScripts(game);
+	StepActors(game->Ticks);
+	UpdateTriggers();
+
+	UpdateSpawns();
+	GenerateQueues();
+	SortQueues();
+}
+
+// runs the actor scripts and cleans up effects on the dead
+void Map::UpdateActorScripts(Game *game)
+{
+	//Run actor scripts (only for 0 priority)
+	int q=Qcount[PR_SCRIPT];
+
+	unsigned __int64 scriptStart = GetMicroTicks();
+	bool overBudget = false;
+	ScriptsDeferred = 0;
+
 	while (q--) {
 		Actor* actor = queue[PR_SCRIPT][q];
 		//actor just moved away, don't run its script from this side
@@ -762,8 +793,19 @@ void Map::UpdateScripts()
 		 * start of this function, or by changing the cutscene state at a later
 		 * point, etc), but i did it this way for now because it seems least painful
 		 * and we should probably be staggering the script executions anyway
+		 * (which we now do for the less important actors once this tick has
+		 * used up its script budget)
 		 */
+		if (!overBudget && core->ScriptBudget) {
+			overBudget = GetMicroTicks() - scriptStart > (unsigned __int64) core->ScriptBudget * 1000;
+		}
+		if (overBudget && CanDeferScript(actor)) {
+			actor->DeferScripts();
+		}
 		actor->Update();
+		if (actor->IsScriptDeferred()) {
+			ScriptsDeferred++;
+		}
 
 		actor->UpdateActorState(game->GameTime);
 
@@ -790,27 +832,43 @@ void Map::UpdateScripts()
 		actor->speed = speed;
 	}
 
+	ScriptTime = (unsigned long) (GetMicroTicks() - scriptStart);
+	if (ScriptsDeferred) {
+		Log(DEBUG, "Map", "%s: %lums of actor scripts, %u script updates put off",
+			scriptName, ScriptTime / 1000, ScriptsDeferred);
+	}
+
 	//clean up effects on dead actors too
 	q=Qcount[PR_DISPLAY];
 	while(q--) {
 		Actor* actor = queue[PR_DISPLAY][q];
 		actor->fxqueue.Cleanup();
 	}
+}
 
-	// We need to step through the list of actors until all of them are done
-	// taking steps.
+// steps every actor until all of them are done taking steps this tick
+void Map::StepActors(ieDword time)
+{
 	bool more_steps = true;
-	ieDword time = game->Ticks; // make sure everything moves at the same time
+	unsigned __int64 moveStart = GetMicroTicks();
 	while (more_steps) {
 		more_steps = false;
 
-		q=Qcount[PR_SCRIPT];
+		int q = Qcount[PR_SCRIPT];
 		while (q--) {
 			Actor* actor = queue[PR_SCRIPT][q];
 			more_steps = !DoStepForActor(actor, actor->speed, time);
 		}
 	}
 
+	MoveTime = (unsigned long) (GetMicroTicks() - moveStart);
+}
+
+// updates doors, containers and infopoints, noting who uses travel regions
+void Map::UpdateTriggers()
+{
+	unsigned __int64 triggerStart = GetMicroTicks();
+
 	//Check if we need to start some door scripts
 	int doorCount = 0;
 	while (true) {
@@ -852,7 +910,7 @@ void Map::UpdateScripts()
 		}
 
 		if (wasActive) {
-			q=Qcount[PR_SCRIPT];
+			int q = Qcount[PR_SCRIPT];
 			ieDword exitID = ip->GetGlobalID();
 			while (q--) {
 				Actor* actor = queue[PR_SCRIPT][q];
@@ -873,7 +931,8 @@ void Map::UpdateScripts()
 					//trigger would be activated anytime
 					//Well, i don't know why is it here, but lets try this
 					if (ip->Entered(actor)) {
-						UseExit(actor, ip);
+						// this may move actors to other maps, so it waits for the merge step
+						pendingExits.push_back(std::make_pair(actor->GetGlobalID(), exitID));
 					}
 				}
 			}
@@ -888,11 +947,57 @@ void Map::UpdateScripts()
 		}
 	}
 
-	UpdateSpawns();
+	TriggerTime = (unsigned long) (GetMicroTicks() - triggerStart);
+}
+
+// the merge step of a tick, run after every map has done its own part,
+// always in map and queue order
+bool Map::ResolvePendingExits()
+{
+	if (pendingExits.empty()) {
+		return false;
+	}
+	std::vector<std::pair<ieDword, ieDword> > exits;
+	exits.swap(pendingExits);
+	for (size_t i = 0; i < exits.size(); i++) {
+		// a previous exit may have already moved the actor away
+		Actor *actor = GetActorByGlobalID(exits[i].first);
+		InfoPoint *ip = GetInfoPointByGlobalID(exits[i].second);
+		if (actor && ip) {
+			UseExit(actor, ip);
+		}
+	}
+	return true;
+}
+
+void Map::RefreshQueues()
+{
 	GenerateQueues();
 	SortQueues();
 }
 
+// party members, anyone fighting or with fresh triggers and anything
+// the player can see always get their scripts run on time
+bool Map::CanDeferScript(Actor *actor) const
+{
+	if (actor->InParty) {
+		return false;
+	}
+	if (actor->LastTarget || actor->TriggerCountdown) {
+		return false;
+	}
+	if (actor->HasPendingTriggers() || (actor->GetInternalFlag() & IF_FORCEUPDATE)) {
+		return false;
+	}
+	if (core->GetGame()->GetCurrentArea() == this) {
+		Region vp = core->GetVideoDriver()->GetViewport();
+		if (vp.PointInside(actor->Pos)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void Map::ResolveTerrainSound(ieResRef &sound, Point &Pos) {
 	for(int i=0;i<tsndcount;i++) {
 		if (!memcmp(sound, terrainsounds[i].Group, sizeof(ieResRef) ) ) {
@@ -1100,8 +1205,6 @@ VEFObject *Map::GetNextScriptedAnimation(scaIterator &iter)
 	return *iter;
 }
 
-static ieDword oldgametime = 0;
-
 //Draw the game area (including overlays, actors, animations, weather)
 void Map::DrawMap(Region screen)
 {
@@ -1219,39 +1322,13 @@ void Map::DrawMap(Region screen)
 			sca = GetNextScriptedAnimation(scaidx);
 			break;
 		case AOT_PROJECTILE:
-			{
-				int drawn;
-				if (gametime>oldgametime) {
-					drawn = pro->Update();
-				} else {
-					drawn = 1;
-				}
-				if (drawn) {
-					pro->Draw( screen );
-					proidx++;
-				} else {
-					delete( pro );
-					proidx = projectiles.erase(proidx);
-				}
-			}
+			pro->Draw( screen );
+			proidx++;
 			pro = GetNextProjectile(proidx);
 			break;
 		case AOT_SPARK:
-			{
-				int drawn;
-				if (gametime>oldgametime) {
-					drawn = spark->Update();
-				} else {
-					drawn = 1;
-				}
-				if (drawn) {
-					spark->Draw( screen );
-					spaidx++;
-				} else {
-					delete( spark );
-					spaidx=particles.erase(spaidx);
-				}
-			}
+			spark->Draw( screen );
+			spaidx++;
 			spark = GetNextSpark(spaidx);
 			break;
 		default:
@@ -1303,8 +1380,6 @@ void Map::DrawMap(Region screen)
 		Actor* actor = actors[i];
 		actor->DrawOverheadText(screen);
 	}
-
-	oldgametime=gametime;
 }
 
 void Map::DrawSearchMap(const Region &screen)
@@ -1321,6 +1396,8 @@ void Map::DrawSearchMap(const Region &screen)
 	int w = screen.w/16+2;
 	int h = screen.h/12+2;
 
+	//one batch per color
+	std::vector<Region> impassibleBlocks, sidewallBlocks, inaccessibleBlocks;
 	for(int x=0;x<w;x++) {
 		for(int y=0;y<h;y++) {
 			unsigned char blockvalue = GetBlocked(x+rgn.x/16, y+rgn.y/12);
@@ -1328,15 +1405,25 @@ void Map::DrawSearchMap(const Region &screen)
 				block.x=screen.x+x*16-(rgn.x % 16);
 				block.y=screen.y+y*12-(rgn.y % 12);
 				if (blockvalue == PATH_MAP_IMPASSABLE) { // 0
-					vid->DrawRect(block,impassible);
+					impassibleBlocks.push_back(block);
 				} else if (blockvalue & PATH_MAP_SIDEWALL) {
-					vid->DrawRect(block,sidewall);
+					sidewallBlocks.push_back(block);
 				} else {
-					vid->DrawRect(block,inaccessible);
+					inaccessibleBlocks.push_back(block);
 				}
 			}
 		}
 	}
+
+	if (!impassibleBlocks.empty()) {
+		vid->DrawRects(&impassibleBlocks[0], impassibleBlocks.size(), impassible);
+	}
+	if (!sidewallBlocks.empty()) {
+		vid->DrawRects(&sidewallBlocks[0], sidewallBlocks.size(), sidewall);
+	}
+	if (!inaccessibleBlocks.empty()) {
+		vid->DrawRects(&inaccessibleBlocks[0], inaccessibleBlocks.size(), inaccessible);
+	}
 }
 
 //adding animation in order, based on its height parameter
@@ -1355,6 +1442,33 @@ void Map::AddAnimation(AreaAnimation* panim)
 	animations.insert(iter, anim);
 }
 
+//the simulation half of projectiles and sparks, run once per game tick by
+//the GlobalTimer, so DrawMap only has to render them (at any frame rate)
+void Map::UpdateProjectiles()
+{
+	proIterator proidx = projectiles.begin();
+	while (proidx != projectiles.end()) {
+		Projectile *pro = *proidx;
+		if (pro->Update()) {
+			proidx++;
+		} else {
+			delete pro;
+			proidx = projectiles.erase(proidx);
+		}
+	}
+
+	spaIterator spaidx = particles.begin();
+	while (spaidx != particles.end()) {
+		Particles *spark = *spaidx;
+		if (spark->Update()) {
+			spaidx++;
+		} else {
+			delete spark;
+			spaidx = particles.erase(spaidx);
+		}
+	}
+}
+
 //reapplying all of the effects on the actors of this map
 //this might be unnecessary later
 void Map::UpdateEffects()
@@ -1497,6 +1611,8 @@ void Map::AddActor(Actor* actor, bool init)
 	strnlwrcpy(actor->Area, scriptName, 8);
 	if (!HasActor(actor)) {
 		actors.push_back( actor );
+		actorIndex.set( actor->GetGlobalID(), actor );
+		actorNameGeneration = 0;
 	}
 	if (init) {
 		actor->SetMap(this);
@@ -1528,6 +1644,8 @@ void Map::DeleteActor(int i)
 {
 	Actor *actor = actors[i];
 	if (actor) {
+		actorIndex.remove( actor->GetGlobalID() );
+		actorNameGeneration = 0;
 		Game *game = core->GetGame();
 		//this makes sure that a PC will be demoted to NPC
 		game->LeaveParty( actor );
@@ -1576,42 +1694,30 @@ Door *Map::GetDoorByGlobalID(ieDword objectID)
 {
 	if (!objectID) return NULL;
 
-	int doorCount = 0;
-	while (true) {
-		Door* door = TMap->GetDoor( doorCount++ );
-		if (!door)
-			return NULL;
-		if (door->GetGlobalID() == objectID)
-			return door;
-	}
+	Scriptable* scr = TMap->GetScriptableByGlobalID(objectID);
+	if (scr && scr->Type == ST_DOOR)
+		return (Door *) scr;
+	return NULL;
 }
 
 Container *Map::GetContainerByGlobalID(ieDword objectID)
 {
 	if (!objectID) return NULL;
 
-	int containerCount = 0;
-	while (true) {
-		Container* container = TMap->GetContainer( containerCount++ );
-		if (!container)
-			return NULL;
-		if (container->GetGlobalID() == objectID)
-			return container;
-	}
+	Scriptable* scr = TMap->GetScriptableByGlobalID(objectID);
+	if (scr && scr->Type == ST_CONTAINER)
+		return (Container *) scr;
+	return NULL;
 }
 
 InfoPoint *Map::GetInfoPointByGlobalID(ieDword objectID)
 {
 	if (!objectID) return NULL;
 
-	int ipCount = 0;
-	while (true) {
-		InfoPoint* ip = TMap->GetInfoPoint( ipCount++ );
-		if (!ip)
-			return NULL;
-		if (ip->GetGlobalID() == objectID)
-			return ip;
-	}
+	Scriptable* scr = TMap->GetScriptableByGlobalID(objectID);
+	if (scr && (scr->Type == ST_PROXIMITY || scr->Type == ST_TRIGGER || scr->Type == ST_TRAVEL))
+		return (InfoPoint *) scr;
+	return NULL;
 }
 
 Actor* Map::GetActorByGlobalID(ieDword objectID)
@@ -1619,15 +1725,8 @@ Actor* Map::GetActorByGlobalID(ieDword objectID)
 	if (!objectID) {
 		return NULL;
 	}
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
-
-		if (actor->GetGlobalID()==objectID) {
-			return actor;
-		}
-	}
-	return NULL;
+	Actor* const* actor = actorIndex.get(objectID);
+	return actor ? *actor : NULL;
 }
 
 /** flags:
@@ -1717,17 +1816,29 @@ Actor **Map::GetAllActorsInRadius(const Point &p, int flags, unsigned int radius
 
 Actor* Map::GetActor(const char* Name, int flags)
 {
-	size_t i = actors.size();
-	while (i--) {
-		Actor* actor = actors[i];
-		if (strnicmp( actor->GetScriptName(), Name, 32 ) == 0) {
-			if (!actor->ValidTarget(flags) ) {
-				return NULL;
-			}
-			return actor;
+	ieDword generation = Scriptable::GetScriptNameGeneration();
+	if (actorNameGeneration != generation) {
+		// later actors overwrite earlier ones, so like before the last one with the name wins
+		actorNameIndex.init(257, 64);
+		for (size_t i = 0; i < actors.size(); i++) {
+			actorNameIndex.set(actors[i]->GetScriptName(), actors[i]);
 		}
+		actorNameGeneration = generation;
 	}
-	return NULL;
+
+	std::string key(Name);
+	if (key.length() > 32) {
+		key.resize(32);
+	}
+	Actor* const* found = actorNameIndex.get(key);
+	if (!found) {
+		return NULL;
+	}
+	Actor* actor = *found;
+	if (!actor->ValidTarget(flags) ) {
+		return NULL;
+	}
+	return actor;
 }
 
 int Map::GetActorCount(bool any) const
@@ -2048,6 +2159,18 @@ unsigned int Map::GetBlocked(const Point &c)
 //	1 - dither if polygon wants it
 //	2 - always dither
 
+void Map::SetWallGroups(unsigned int count, Wall_Polygon **walls)
+{
+	WallCount = count;
+	Walls = walls;
+	wallGrid.Clear();
+	for (unsigned int i = 0; i < count; i++) {
+		if (walls[i]) {
+			wallGrid.Insert(walls[i], walls[i]->BBox);
+		}
+	}
+}
+
 SpriteCover* Map::BuildSpriteCover(int x, int y, int xpos, int ypos,
 	unsigned int width, unsigned int height, int flags, bool areaanim)
 {
@@ -2062,13 +2185,13 @@ SpriteCover* Map::BuildSpriteCover(int x, int y, int xpos, int ypos,
 	Video* video = core->GetVideoDriver();
 	video->InitSpriteCover(sc, flags);
 
-	unsigned int wpcount = GetWallCount();
-	unsigned int i;
+	//only wallgroups overlapping the sprite can cover any of it
+	std::vector<Wall_Polygon*> candidates;
+	wallGrid.Query(Region(x - xpos, y - ypos, width, height), candidates);
 
-	for (i = 0; i < wpcount; ++i)
+	for (size_t i = 0; i < candidates.size(); ++i)
 	{
-		Wall_Polygon* wp = GetWallGroup(i);
-		if (!wp) continue;
+		Wall_Polygon* wp = candidates[i];
 		if (!wp->PointCovered(x, y)) continue;
 		if (areaanim && !(wp->GetPolygonFlag() & WF_COVERANIMS)) continue;
 
@@ -2327,13 +2450,8 @@ Entrance* Map::GetEntrance(const char* Name)
 
 bool Map::HasActor(Actor *actor)
 {
-	size_t i=actors.size();
-	while (i--) {
-		if (actors[i] == actor) {
-			return true;
-		}
-	}
-	return false;
+	Actor* const* found = actorIndex.get(actor->GetGlobalID());
+	return found && *found == actor;
 }
 
 void Map::RemoveActor(Actor* actor)
@@ -2347,6 +2465,8 @@ void Map::RemoveActor(Actor* actor)
 			actor->SetMap(NULL);
 			CopyResRef(actor->Area, "");
 			actors.erase( actors.begin()+i );
+			actorIndex.remove( actor->GetGlobalID() );
+			actorNameGeneration = 0;
 			return;
 		}
 	}
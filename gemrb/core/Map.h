@@ -24,7 +24,10 @@
 #include "exports.h"
 #include "globals.h"
 
+#include "HashMap.h"
 #include "Interface.h"
+#include "SpatialGrid.h"
+#include "StringMap.h"
 #include "Scriptable/Scriptable.h"
 
 #include <algorithm>
@@ -314,6 +317,11 @@ public:
 	ieDword BgDuration;
 	ieDword LastGoCloser;
 	MapReverb *reverb;
+	// actor script profiling for the last tick
+	unsigned long ScriptTime; // microseconds spent in actor updates
+	unsigned long MoveTime; // microseconds spent stepping actors
+	unsigned long TriggerTime; // microseconds spent on doors, containers and infopoints
+	unsigned int ScriptsDeferred; // due script updates put off
 
 private:
 	ieStrRef trackString;
@@ -326,8 +334,14 @@ private:
 	unsigned int Width, Height;
 	std::list< AreaAnimation*> animations;
 	std::vector< Actor*> actors;
+	// actors by global ID, kept up to date as they enter and leave
+	HashMap<ieDword, Actor*> actorIndex;
+	// actors by script name, rebuilt on demand since names can change any time
+	HashMap<std::string, Actor*> actorNameIndex;
+	ieDword actorNameGeneration;
 	Wall_Polygon **Walls;
 	unsigned int WallCount;
+	SpatialGrid<Wall_Polygon> wallGrid;
 	std::list< VEFObject*> vvcCells;
 	std::list< Projectile*> projectiles;
 	std::list< Particles*> particles;
@@ -338,6 +352,8 @@ private:
 	Actor** queue[QUEUE_COUNT];
 	int Qcount[QUEUE_COUNT];
 	unsigned int lastActorCount[QUEUE_COUNT];
+	// travel region uses (actor and infopoint global IDs) waiting for ResolvePendingExits
+	std::vector<std::pair<ieDword, ieDword> > pendingExits;
 public:
 	Map(void);
 	~Map(void);
@@ -354,9 +370,19 @@ public:
 	/* sets all the auxiliary maps and the tileset */
 	void AddTileMap(TileMap* tm, Image* lm, Bitmap* sr, Sprite2D* sm, Bitmap* hm);
 	void UpdateScripts();
+	/* uses the travel regions entered during UpdateScripts, the cross-map
+	part of a tick, done once all maps have been updated; returns true if
+	any exit was used */
+	bool ResolvePendingExits();
+	/* rebuilds the actor queues, for when actors changed maps after UpdateScripts */
+	void RefreshQueues();
+	/* whether the actor's script may be put off when over the script budget */
+	bool CanDeferScript(Actor *actor) const;
 	void ResolveTerrainSound(ieResRef &sound, Point &pos);
 	bool DoStepForActor(Actor *actor, int speed, ieDword time);
 	void UpdateEffects();
+	/* advances projectiles and particles by one game tick, reaping finished ones */
+	void UpdateProjectiles();
 	/* removes empty heaps and returns total itemcount */
 	int ConsolidateContainers();
 	/* transfers all piles (loose items) to another map */
@@ -382,11 +408,7 @@ public:
 
 	unsigned int GetWallCount() { return WallCount; }
 	Wall_Polygon *GetWallGroup(int i) { return Walls[i]; }
-	void SetWallGroups(unsigned int count, Wall_Polygon **walls)
-	{
-		WallCount = count;
-		Walls = walls;
-	}
+	void SetWallGroups(unsigned int count, Wall_Polygon **walls);
 	SpriteCover* BuildSpriteCover(int x, int y, int xpos, int ypos,
 		unsigned int width, unsigned int height, int flag, bool areaanim = false);
 	void ActivateWallgroups(unsigned int baseindex, unsigned int count, int flg);
@@ -568,6 +590,10 @@ private:
 	void DrawSearchMap(const Region &screen);
 	void GenerateQueues();
 	void SortQueues();
+	// the per-map phases of UpdateScripts
+	void UpdateActorScripts(Game *game);
+	void StepActors(ieDword time);
+	void UpdateTriggers();
 	//Actor* GetRoot(int priority, int &index);
 	void DeleteActor(int i);
 	void Leveldown(unsigned int px, unsigned int py, unsigned int& level,
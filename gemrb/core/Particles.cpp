@@ -26,6 +26,8 @@
 #include "TableMgr.h"
 #include "Video.h"
 
+#include <vector>
+
 namespace GemRB {
 
 Color sparkcolors[MAX_SPARK_COLOR][MAX_SPARK_PHASE];
@@ -203,6 +205,15 @@ void Particles::Draw(const Region &screen)
 		region.x-=pos.x;
 		region.y-=pos.y;
 	}
+
+	//the primitive types are collected and handed to the video driver in one go
+	std::vector<Point> shapes;
+	std::vector<Color> shapeColors;
+	if (type != SP_TYPE_BITMAP) {
+		shapes.reserve(type == SP_TYPE_LINE ? 2*size : size);
+		shapeColors.reserve(size);
+	}
+
 	int i = size;
 	while (i--) {
 		if (points[i].state == -1) {
@@ -254,25 +265,39 @@ void Particles::Draw(const Region &screen)
 			}
 			break;
 		case SP_TYPE_CIRCLE:
-			video->DrawCircle (points[i].pos.x-region.x,
-				points[i].pos.y-region.y, 2, clr, true);
-			break;
 		case SP_TYPE_POINT:
 		default:
-			video->SetPixel (points[i].pos.x-region.x,
-				points[i].pos.y-region.y, clr, true);
+			shapes.push_back(Point(points[i].pos.x-region.x, points[i].pos.y-region.y));
+			shapeColors.push_back(clr);
 			break;
 		// this is more like a raindrop
 		case SP_TYPE_LINE:
 			if (length) {
-				video->DrawLine (points[i].pos.x+region.x,
-					points[i].pos.y+region.y,
-					points[i].pos.x+region.x+(i&1),
-					points[i].pos.y+region.y+length, clr, true);
+				shapes.push_back(Point(points[i].pos.x+region.x, points[i].pos.y+region.y));
+				shapes.push_back(Point(points[i].pos.x+region.x+(i&1), points[i].pos.y+region.y+length));
+				shapeColors.push_back(clr);
 			}
 			break;
 		}
 	}
+
+	if (shapeColors.empty()) {
+		return;
+	}
+	switch (type) {
+	case SP_TYPE_BITMAP:
+		break;
+	case SP_TYPE_CIRCLE:
+		video->DrawCircles(&shapes[0], &shapeColors[0], shapeColors.size(), 2, true);
+		break;
+	case SP_TYPE_LINE:
+		video->DrawLines(&shapes[0], &shapeColors[0], shapeColors.size(), true);
+		break;
+	case SP_TYPE_POINT:
+	default:
+		video->DrawPoints(&shapes[0], &shapeColors[0], shapeColors.size(), true);
+		break;
+	}
 }
 
 void Particles::AddParticles(int count)
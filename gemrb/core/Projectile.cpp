@@ -1245,9 +1245,27 @@ int Projectile::Update()
 	if (phase == P_TRAVEL || phase == P_TRAVEL2) {
 		DoStep(Speed);
 	}
+
+	switch (phase) {
+		case P_UNINITED: case P_TRAVEL: case P_TRAVEL2:
+			break;
+		case P_TRIGGER: case P_EXPLODING1: case P_EXPLODING2:
+			CheckTrigger(Extension->TriggerRadius);
+			if (phase == P_EXPLODING1 || phase == P_EXPLODING2) {
+				UpdateExplosion();
+			}
+			break;
+		default:
+			//wait until all children expire
+			if (!UpdateChildren()) {
+				phase = P_EXPIRED;
+			}
+			break;
+	}
 	return 1;
 }
 
+//only renders, the phases are handled by Update
 void Projectile::Draw(const Region &screen)
 {
 	switch (phase) {
@@ -1260,13 +1278,8 @@ void Projectile::Draw(const Region &screen)
 			//if (!Extension || (Extension->AFlags&PAF_VISIBLE)) {
 				DrawTravel(screen);
 			}
-			/*
-			if (!Extension) {
-				return;
-			}*/
-			CheckTrigger(Extension->TriggerRadius);
 			if (phase == P_EXPLODING1 || phase == P_EXPLODING2) {
-				DrawExplosion(screen);
+				DrawChildren(screen);
 			}
 			break;
 		case P_TRAVEL: case P_TRAVEL2:
@@ -1274,21 +1287,21 @@ void Projectile::Draw(const Region &screen)
 			DrawTravel(screen);
 			return;
 		default:
-			DrawExploded(screen);
+			DrawChildren(screen);
 			return;
 	}
 }
 
-bool Projectile::DrawChildren(const Region &screen)
+//steps the explosion children, returns false once all of them expired
+bool Projectile::UpdateChildren()
 {
-	bool drawn = false;
+	bool alive = false;
 
 	if (children) {
 		for(int i=0;i<child_size;i++){
 			if(children[i]) {
 				if (children[i]->Update()) {
-					children[i]->DrawTravel(screen);
-					drawn = true;
+					alive = true;
 				} else {
 					delete children[i];
 					children[i]=NULL;
@@ -1297,16 +1310,18 @@ bool Projectile::DrawChildren(const Region &screen)
 		}
 	}
 
-	return drawn;
+	return alive;
 }
 
-//draw until all children expire
-void Projectile::DrawExploded(const Region &screen)
+void Projectile::DrawChildren(const Region &screen)
 {
-	if (DrawChildren(screen)) {
-		return;
+	if (children) {
+		for(int i=0;i<child_size;i++){
+			if(children[i]) {
+				children[i]->DrawTravel(screen);
+			}
+		}
 	}
-	phase = P_EXPIRED;
 }
 
 void Projectile::SpawnFragment(Point &dest)
@@ -1325,7 +1340,7 @@ void Projectile::SpawnFragment(Point &dest)
 	}
 }
 
-void Projectile::DrawExplosion(const Region &screen)
+void Projectile::UpdateExplosion()
 {
 	//This seems to be a needless safeguard
 	if (!Extension) {
@@ -1334,12 +1349,7 @@ void Projectile::DrawExplosion(const Region &screen)
 	}
 
 	StopSound();
-	DrawChildren(screen);
-
-	int pause = core->IsFreezed();
-	if (pause) {
-		return;
-	}
+	UpdateChildren();
 
 	//Delay explosion, it could even be revoked with PAF_SYNC (see skull trap)
 	if (extension_delay) {
@@ -1379,10 +1389,7 @@ void Projectile::DrawExplosion(const Region &screen)
 		//Extension->ExplColor fake color for single shades (blue,green,red flames)
 		//Extension->FragAnimID the animation id for the character animation
 		//This color is not used in the original game
-		Point pos = Pos;
-		pos.x+=screen.x;
-		pos.y+=screen.y;
-		area->Sparkle(0, Extension->ExplColor, SPARKLE_EXPLOSION, pos, Extension->FragAnimID, GetZPos());
+		area->Sparkle(0, Extension->ExplColor, SPARKLE_EXPLOSION, Pos, Extension->FragAnimID, GetZPos());
 	}
 
 	if(Shake) {
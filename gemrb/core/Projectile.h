@@ -392,10 +392,10 @@ private:
 	void SetupWall();
 	void DrawLine(const Region &screen, int face, ieDword flag);
 	void DrawTravel(const Region &screen);
-	bool DrawChildren(const Region &screen);
-	void DrawExplosion(const Region &screen);
+	bool UpdateChildren();
+	void DrawChildren(const Region &screen);
+	void UpdateExplosion();
 	void SpawnFragment(Point &pos);
-	void DrawExploded(const Region &screen);
 	int GetTravelPos(int face) const;
 	int GetShadowPos(int face) const;
 	void SetPos(int face, int frame1, int frame2);
@@ -37,6 +37,14 @@ RNG_SFMT::RNG_SFMT() {
   sfmt_init_gen_rand(&sfmt, seed);
 }
 
+/**
+ * Reinitializes the internal state with a fixed seed instead of the timestamp,
+ * so the same sequence of numbers can be generated again (eg. for benchmarks).
+ */
+void RNG_SFMT::seed(uint32_t seed) {
+  sfmt_init_gen_rand(&sfmt, seed);
+}
+
 /**
  * This creates an instance of the singleton class RNG_SFMT. Call this instead of the
  * constructor.
@@ -52,6 +52,8 @@ public:
    * RAND(min, max);
    */
   unsigned int rand(int min = 0, int max = INT_MAX-1);
+  // reseeds the generator, so runs can be reproduced
+  void seed(uint32_t seed);
   static RNG_SFMT* getInstance();
 };
 
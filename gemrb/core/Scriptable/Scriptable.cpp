@@ -43,6 +43,7 @@ namespace GemRB {
 
 // we start this at a non-zero value to make debugging easier
 static ieDword globalActorCounter = 10000;
+static ieDword scriptNameGeneration = 1;
 static bool startActive = false;
 static bool third = false;
 static bool pst_flags = false;
@@ -94,6 +95,8 @@ Scriptable::Scriptable(ScriptableType type)
 	IdleTicks = 0;
 	AuraTicks = 100;
 	TriggerCountdown = 0;
+	ScriptDeferrals = 0;
+	deferScripts = false;
 	Dialog[0] = 0;
 
 	globalID = ++globalActorCounter;
@@ -148,9 +151,18 @@ void Scriptable::SetScriptName(const char* text)
 	//lets hope this won't break anything
 	if (text) {
 		strnspccpy( scriptName, text, 32 );
+		// 0 is never used, so it can mark stale name indices
+		if (!++scriptNameGeneration) {
+			++scriptNameGeneration;
+		}
 	}
 }
 
+ieDword Scriptable::GetScriptNameGeneration()
+{
+	return scriptNameGeneration;
+}
+
 /** Gets the DeathVariable */
 const char* Scriptable::GetScriptName(void) const
 {
@@ -327,12 +339,28 @@ void Scriptable::Update()
 	InterruptCasting = false;
 }
 
+#define MAX_SCRIPT_DEFERRALS 8
+
 void Scriptable::TickScripting()
 {
+	bool defer = deferScripts;
+	deferScripts = false;
+
 	// Stagger script updates.
-	if (Ticks % 16 != globalID % 16)
+	if (Ticks % 16 != globalID % 16 && !ScriptDeferrals)
 		return;
 
+	// a forced update (fresh triggers) is never deferred
+	bool forced = (InternalFlags & IF_FORCEUPDATE) != 0;
+
+	// the area is over its script budget, try again next tick,
+	// but don't let a busy area starve anyone for long
+	if (defer && !forced && ScriptDeferrals < MAX_SCRIPT_DEFERRALS) {
+		ScriptDeferrals++;
+		return;
+	}
+	ScriptDeferrals = 0;
+
 	ieDword actorState = 0;
 	if (Type == ST_ACTOR)
 		actorState = ((Actor *)this)->Modified[IE_STATE_ID];
@@ -347,7 +375,7 @@ void Scriptable::TickScripting()
 	bool needsUpdate = (!CurrentAction) || (TriggerCountdown > 0) || (IdleTicks > 15);
 
 	// Also do a script update if one was forced..
-	if (InternalFlags & IF_FORCEUPDATE) {
+	if (forced) {
 		needsUpdate = true;
 		InternalFlags &= ~IF_FORCEUPDATE;
 	}
@@ -671,14 +699,16 @@ void Scriptable::SetInternalFlag(unsigned int value, int mode)
 void Scriptable::InitTriggers()
 {
 	triggers.clear();
+	triggerMask.reset();
 }
 
 void Scriptable::AddTrigger(TriggerEntry trigger)
 {
+	assert(trigger.triggerID < MAX_TRIGGER_EVENTS);
 	triggers.push_back(trigger);
+	triggerMask.set(trigger.triggerID);
 	ImmediateEvent();
 
-	assert(trigger.triggerID < MAX_TRIGGERS);
 	if (triggerflags[trigger.triggerID] & TF_SAVED) {
 		//TODO: if LastTrigger is still overwritten by script action blocks, store this in a separate field and copy it back when the block ends
 		//Log(WARNING, "Scriptable", "%s: Added LastTrigger: %d for trigger %d\n", scriptName, trigger.param1, trigger.triggerID);
@@ -687,6 +717,7 @@ void Scriptable::AddTrigger(TriggerEntry trigger)
 }
 
 bool Scriptable::MatchTrigger(unsigned short id, ieDword param) {
+	if (!HasTrigger(id)) return false;
 	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
 		TriggerEntry &trigger = *m;
 		if (trigger.triggerID != id)
@@ -700,6 +731,7 @@ bool Scriptable::MatchTrigger(unsigned short id, ieDword param) {
 }
 
 bool Scriptable::MatchTriggerWithObject(unsigned short id, class Object *obj, ieDword param) {
+	if (!HasTrigger(id)) return false;
 	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
 		TriggerEntry &trigger = *m;
 		if (trigger.triggerID != id)
@@ -715,6 +747,7 @@ bool Scriptable::MatchTriggerWithObject(unsigned short id, class Object *obj, ie
 }
 
 const TriggerEntry *Scriptable::GetMatchingTrigger(unsigned short id, unsigned int notflags) {
+	if (!HasTrigger(id)) return NULL;
 	for (std::list<TriggerEntry>::iterator m = triggers.begin(); m != triggers.end (); m++) {
 		TriggerEntry &trigger = *m;
 		if (trigger.triggerID != id)
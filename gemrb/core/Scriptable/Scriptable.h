@@ -25,6 +25,7 @@
 
 #include "Variables.h"
 
+#include <bitset>
 #include <list>
 #include <map>
 
@@ -182,6 +183,9 @@ enum {
 	trigger_walkedtotrigger = 0xd6 // bg2
 };
 
+// must be above the highest trigger_* id
+#define MAX_TRIGGER_EVENTS 0x100
+
 // flags for TriggerEntry
 enum {
 	// has the effect queue (if any) been processed since this trigger
@@ -211,10 +215,13 @@ public:
 	virtual ~Scriptable(void);
 private:
 	unsigned long WaitCounter;
+	bool deferScripts;
 	std::map<ieDword,ieDword> script_timers;
 	ieDword globalID;
 protected: //let Actor access this
 	std::list<TriggerEntry> triggers;
+	// which trigger ids are currently queued in triggers
+	std::bitset<MAX_TRIGGER_EVENTS> triggerMask;
 	Map *area;
 	ieVariable scriptName;
 	ieDword InternalFlags; //for triggers
@@ -246,6 +253,8 @@ public:
 	ieDword AuraTicks;
 	// The countdown for forced activation by triggers.
 	ieDword TriggerCountdown;
+	// Consecutive ticks a due script update was put off by the area.
+	ieDword ScriptDeferrals;
 
 	Variables* locals;
 	ScriptableType Type;
@@ -316,11 +325,16 @@ public:
 	bool OverheadTextIsDisplaying() { return overheadTextDisplaying; }
 	void FixHeadTextPos();
 	void SetScriptName(const char* text);
+	/* changes whenever any scriptable is renamed, so name lookups know when to reindex */
+	static ieDword GetScriptNameGeneration();
 	//call this to enable script running as soon as possible
 	void ImmediateEvent();
 	bool IsPC() const;
 	virtual void Update();
 	void TickScripting();
+	/* puts off a script update due this tick until the next one */
+	void DeferScripts() { deferScripts = true; }
+	bool IsScriptDeferred() const { return ScriptDeferrals != 0; }
 	virtual void ExecuteScript(int scriptCount);
 	void AddAction(Action* aC);
 	void AddActionInFront(Action* aC);
@@ -336,6 +350,8 @@ public:
 	//true condition (whole triggerblock returned true)
 	void InitTriggers();
 	void AddTrigger(TriggerEntry trigger);
+	bool HasTrigger(unsigned short id) const { return id < MAX_TRIGGER_EVENTS && triggerMask.test(id); }
+	bool HasPendingTriggers() const { return !triggers.empty(); }
 	bool MatchTrigger(unsigned short id, ieDword param = 0);
 	bool MatchTriggerWithObject(unsigned short id, class Object *obj, ieDword param = 0);
 	const TriggerEntry *GetMatchingTrigger(unsigned short id, unsigned int notflags = 0);
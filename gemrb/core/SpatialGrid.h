@@ -0,0 +1,155 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "Region.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace GemRB {
+
+/**
+ * @class SpatialGrid
+ * Uniform grid over area coordinates, bucketing objects by their bounding
+ * box, so point and region lookups only have to test nearby candidates.
+ * Bounding boxes are inclusive on all edges, like Gem_Polygon::BBox.
+ * Within a cell, candidates keep their insertion order.
+ */
+
+template <class T>
+class SpatialGrid {
+private:
+	struct Entry {
+		T* obj;
+		Region bbox;
+	};
+	enum { CellSize = 256 };
+
+	std::vector<Entry> entries;
+	std::vector< std::vector<T*> > cells;
+	int cols, rows;
+
+	static int CellOf(int coord, int count)
+	{
+		if (coord < 0) return 0;
+		int cell = coord / CellSize;
+		return cell < count ? cell : count - 1;
+	}
+
+	void AddToCells(const Entry& entry)
+	{
+		int x1 = CellOf(entry.bbox.x, cols);
+		int x2 = CellOf(entry.bbox.x + entry.bbox.w, cols);
+		int y1 = CellOf(entry.bbox.y, rows);
+		int y2 = CellOf(entry.bbox.y + entry.bbox.h, rows);
+		for (int y = y1; y <= y2; y++) {
+			for (int x = x1; x <= x2; x++) {
+				cells[y * cols + x].push_back(entry.obj);
+			}
+		}
+	}
+
+	// grows the grid to cover bbox, rebucketing everything
+	void Cover(const Region& bbox)
+	{
+		int needCols = std::max(cols, (bbox.x + bbox.w) / CellSize + 1);
+		int needRows = std::max(rows, (bbox.y + bbox.h) / CellSize + 1);
+		if (needCols == cols && needRows == rows) {
+			return;
+		}
+		cols = needCols;
+		rows = needRows;
+		cells.clear();
+		cells.resize(cols * rows);
+		for (size_t i = 0; i < entries.size(); i++) {
+			AddToCells(entries[i]);
+		}
+	}
+
+public:
+	SpatialGrid() : cols(1), rows(1) { cells.resize(1); }
+
+	void Clear()
+	{
+		entries.clear();
+		cells.clear();
+		cols = rows = 1;
+		cells.resize(1);
+	}
+
+	void Insert(T* obj, const Region& bbox)
+	{
+		Entry entry = { obj, bbox };
+		entries.push_back(entry);
+		Cover(bbox);
+		AddToCells(entry);
+	}
+
+	void Remove(T* obj)
+	{
+		for (size_t i = 0; i < entries.size(); i++) {
+			if (entries[i].obj != obj) continue;
+			int x1 = CellOf(entries[i].bbox.x, cols);
+			int x2 = CellOf(entries[i].bbox.x + entries[i].bbox.w, cols);
+			int y1 = CellOf(entries[i].bbox.y, rows);
+			int y2 = CellOf(entries[i].bbox.y + entries[i].bbox.h, rows);
+			for (int y = y1; y <= y2; y++) {
+				for (int x = x1; x <= x2; x++) {
+					std::vector<T*>& cell = cells[y * cols + x];
+					cell.erase(std::find(cell.begin(), cell.end(), obj));
+				}
+			}
+			entries.erase(entries.begin() + i);
+			return;
+		}
+	}
+
+	/** candidates whose bounding box may contain p */
+	const std::vector<T*>& Query(const Point& p) const
+	{
+		return cells[CellOf(p.y, rows) * cols + CellOf(p.x, cols)];
+	}
+
+	/** candidates whose bounding box may intersect rgn, each listed once, in no particular order */
+	void Query(const Region& rgn, std::vector<T*>& out) const
+	{
+		int x1 = CellOf(rgn.x, cols);
+		int x2 = CellOf(rgn.x + rgn.w, cols);
+		int y1 = CellOf(rgn.y, rows);
+		int y2 = CellOf(rgn.y + rgn.h, rows);
+		for (int y = y1; y <= y2; y++) {
+			for (int x = x1; x <= x2; x++) {
+				const std::vector<T*>& cell = cells[y * cols + x];
+				out.insert(out.end(), cell.begin(), cell.end());
+			}
+		}
+		if (x1 != x2 || y1 != y2) {
+			std::sort(out.begin(), out.end());
+			out.erase(std::unique(out.begin(), out.end()), out.end());
+		}
+	}
+};
+
+}
+
+#endif
@@ -51,6 +51,8 @@ Spellbook::Spellbook()
 	}
 	spells = new std::vector<CRESpellMemorization*> [NUM_BOOK_TYPES];
 	sorcerer = 0;
+	totalKnown = totalCharged = 0;
+	indexDirty = true;
 	if (IWD2Style) {
 		innate = 1<<IE_IWD2_SPELL_INNATE;
 	} else {
@@ -122,7 +124,7 @@ void Spellbook::CopyFrom(const Actor *source)
 		}
 		spells[i].clear();
 	}
-	ClearSpellInfo();
+	InvalidateSpells();
 
 	const Spellbook &wikipedia = source->spellbook;
 
@@ -213,6 +215,14 @@ bool Spellbook::HaveSpell(int spellid, ieDword flags)
 }
 bool Spellbook::HaveSpell(int spellid, int type, ieDword flags)
 {
+	const SpellCounts *counts = FindIndexEntry(spellid);
+	if (!counts || !counts->charged[type]) {
+		return false;
+	}
+	if (!(flags&HS_DEPLETE)) {
+		return true;
+	}
+
 	for (unsigned int j = 0; j < GetSpellLevelCount(type); j++) {
 		CRESpellMemorization* sm = spells[type][j];
 		for (unsigned int k = 0; k < sm->memorized_spells.size(); k++) {
@@ -241,23 +251,23 @@ int Spellbook::CountSpells(const char *resref, unsigned int type, int flag) cons
 	if (type==0xffffffff) {
 		i=0;
 		max = NUM_BOOK_TYPES;
-	} else {
+	} else if (type < (unsigned int) NUM_BOOK_TYPES) {
 		i = type;
 		max = i+1;
+	} else {
+		return 0;
+	}
+
+	if (!resref[0]) {
+		return 0;
+	}
+	const SpellCounts *counts = FindIndexEntry(resref);
+	if (!counts) {
+		return 0;
 	}
 
 	while(i < max) {
-		for (unsigned int j = 0; j < spells[i].size(); j++) {
-			CRESpellMemorization* sm = spells[i][j];
-			for (unsigned int k = 0; k < sm->memorized_spells.size(); k++) {
-				CREMemorizedSpell* ms = sm->memorized_spells[k];
-				if (resref[0] && !stricmp(ms->SpellResRef, resref) ) {
-					if (flag || ms->Flags) {
-						count++;
-					}
-				}
-			}
-		}
+		count += flag ? counts->memorized[i] : counts->charged[i];
 		i++;
 	}
 	return count;
@@ -287,31 +297,24 @@ bool Spellbook::KnowSpell(int spellid) const
 
 bool Spellbook::KnowSpell(int spellid, int type) const
 {
-	for (unsigned int j = 0; j < GetSpellLevelCount(type); j++) {
-		CRESpellMemorization* sm = spells[type][j];
-		for (unsigned int k = 0; k < sm->known_spells.size(); k++) {
-			CREKnownSpell* ks = sm->known_spells[k];
-			if (atoi(ks->SpellResRef+4)==spellid) {
-				return true;
-			}
-		}
-	}
-	return false;
+	const SpellCounts *counts = FindIndexEntry(spellid);
+	return counts && counts->known[type];
 }
 
 //if resref=="" then it is a knownanyspell
 bool Spellbook::KnowSpell(const char *resref) const
 {
+	if (!resref[0]) {
+		UpdateIndex();
+		return totalKnown != 0;
+	}
+	const SpellCounts *counts = FindIndexEntry(resref);
+	if (!counts) {
+		return false;
+	}
 	for (int i = 0; i < NUM_BOOK_TYPES; i++) {
-		for (unsigned int j = 0; j < spells[i].size(); j++) {
-			CRESpellMemorization* sm = spells[i][j];
-			for (unsigned int k = 0; k < sm->known_spells.size(); k++) {
-				CREKnownSpell* ks = sm->known_spells[k];
-				if (resref[0] && stricmp(ks->SpellResRef, resref) ) {
-					continue;
-				}
-				return true;
-			}
+		if (counts->known[i]) {
+			return true;
 		}
 	}
 	return false;
@@ -320,6 +323,28 @@ bool Spellbook::KnowSpell(const char *resref) const
 //if resref=="" then it is a haveanyspell
 bool Spellbook::HaveSpell(const char *resref, ieDword flags)
 {
+	if (resref[0]) {
+		const SpellCounts *counts = FindIndexEntry(resref);
+		if (!counts) {
+			return false;
+		}
+		int i;
+		for (i = 0; i < NUM_BOOK_TYPES; i++) {
+			if (counts->charged[i]) break;
+		}
+		if (i == NUM_BOOK_TYPES) {
+			return false;
+		}
+	} else {
+		UpdateIndex();
+		if (!totalCharged) {
+			return false;
+		}
+	}
+	if (!(flags&HS_DEPLETE)) {
+		return true;
+	}
+
 	for (int i = 0; i < NUM_BOOK_TYPES; i++) {
 		for (unsigned int j = 0; j < spells[i].size(); j++) {
 			CRESpellMemorization* sm = spells[i][j];
@@ -430,7 +455,7 @@ bool Spellbook::RemoveSpell(CREKnownSpell* spell)
 					delete *ks;
 					(*sm)->known_spells.erase(ks);
 					RemoveMemorization(*sm, ResRef);
-					ClearSpellInfo();
+					InvalidateSpells();
 					return true;
 				}
 			}
@@ -476,7 +501,7 @@ void Spellbook::RemoveSpell(int spellid, int type)
 				(*sm)->known_spells.erase(ks);
 				RemoveMemorization(*sm, ResRef);
 				ks--;
-				ClearSpellInfo();
+				InvalidateSpells();
 			}
 		}
 	}
@@ -498,7 +523,7 @@ void Spellbook::RemoveSpell(const ieResRef ResRef)
 				(*sm)->known_spells.erase(ks);
 				RemoveMemorization(*sm, ResRef);
 				ks--;
-				ClearSpellInfo();
+				InvalidateSpells();
 			}
 		}
 	}
@@ -571,6 +596,7 @@ bool Spellbook::AddKnownSpell(CREKnownSpell *spl, int flg)
 	}
 
 	spells[type][level]->known_spells.push_back(spl);
+	InvalidateSpells();
 	if (1<<type == innate || 1<<type == 1<<IE_IWD2_SPELL_SONG) {
 		spells[type][level]->SlotCount++;
 		spells[type][level]->SlotCountWithBonus++;
@@ -633,18 +659,14 @@ unsigned int Spellbook::GetMemorizedSpellsCount(const ieResRef name, int type, b
 		t = type;
 	}
 
+	const SpellCounts *counts = FindIndexEntry(name);
+	if (!counts) {
+		return 0;
+	}
+
 	int j = 0;
 	while(t>=0) {
-		unsigned int level = GetSpellLevelCount(t);
-		while(level--) {
-			int i = spells[t][level]->memorized_spells.size();
-			while(i--) {
-				CREMemorizedSpell *cms = spells[t][level]->memorized_spells[i];
-
-				if (strnicmp(cms->SpellResRef, name, sizeof(ieResRef) ) ) continue;
-				if (!real || cms->Flags) j++;
-			}
-		}
+		j += real ? counts->charged[t] : counts->memorized[t];
 		if (type>=0) break;
 		t--;
 	}
@@ -791,7 +813,7 @@ bool Spellbook::MemorizeSpell(CREKnownSpell* spell, bool usable)
 	mem_spl->Flags = usable ? 1 : 0; // FIXME: is it all it's used for?
 
 	sm->memorized_spells.push_back( mem_spl );
-	ClearSpellInfo();
+	InvalidateSpells();
 	return true;
 }
 
@@ -805,7 +827,7 @@ bool Spellbook::UnmemorizeSpell(CREMemorizedSpell* spell)
 				if (*s == spell) {
 					delete *s;
 					(*sm)->memorized_spells.erase( s );
-					ClearSpellInfo();
+					InvalidateSpells();
 					return true;
 				}
 			}
@@ -834,7 +856,7 @@ bool Spellbook::UnmemorizeSpell(const ieResRef ResRef, bool deplete, bool onlyde
 					delete *s;
 					(*sm)->memorized_spells.erase( s );
 				}
-				ClearSpellInfo();
+				InvalidateSpells();
 				return true;
 			}
 		}
@@ -883,6 +905,7 @@ void Spellbook::CreateSorcererMemory(int type)
 			delete sm->memorized_spells[cnt];
 		}
 		sm->memorized_spells.clear();
+		InvalidateSpells();
 		for (unsigned int k = 0; k < sm->known_spells.size(); k++) {
 			CREKnownSpell *ck = sm->known_spells[k];
 			cnt = sm->SlotCountWithBonus;
@@ -954,6 +977,7 @@ void Spellbook::DepleteLevel(CRESpellMemorization* sm, const ieResRef except)
 */
 		}
 	}
+	InvalidateSpells();
 }
 
 bool Spellbook::DepleteSpell(int type, unsigned int page, unsigned int slot)
@@ -983,7 +1007,7 @@ bool Spellbook::DepleteSpell(int type, unsigned int page, unsigned int slot)
 bool Spellbook::ChargeSpell(CREMemorizedSpell* spl)
 {
 	spl->Flags = 1;
-	ClearSpellInfo();
+	InvalidateSpells();
 	return true;
 }
 
@@ -991,7 +1015,7 @@ bool Spellbook::DepleteSpell(CREMemorizedSpell* spl)
 {
 	if (spl->Flags) {
 		spl->Flags = 0;
-		ClearSpellInfo();
+		InvalidateSpells();
 		return true;
 	}
 	return false;
@@ -1006,6 +1030,86 @@ void Spellbook::ClearSpellInfo()
 	spellinfo.clear();
 }
 
+void Spellbook::InvalidateSpells()
+{
+	ClearSpellInfo();
+	indexDirty = true;
+}
+
+// tallies every known and memorized spell by resref and by spell number
+void Spellbook::UpdateIndex() const
+{
+	if (!indexDirty) {
+		return;
+	}
+	nameIndex.init(31, 16);
+	numberIndex.init(31, 16);
+	indexCounts.clear();
+	totalKnown = totalCharged = 0;
+
+	for (int i = 0; i < NUM_BOOK_TYPES; i++) {
+		for (unsigned int j = 0; j < spells[i].size(); j++) {
+			CRESpellMemorization* sm = spells[i][j];
+			for (unsigned int k = 0; k < sm->known_spells.size(); k++) {
+				CREKnownSpell* ks = sm->known_spells[k];
+				IndexEntry(ks->SpellResRef, false).known[i]++;
+				IndexEntry(ks->SpellResRef, true).known[i]++;
+				totalKnown++;
+			}
+			for (unsigned int k = 0; k < sm->memorized_spells.size(); k++) {
+				CREMemorizedSpell* ms = sm->memorized_spells[k];
+				int charged = ms->Flags ? 1 : 0;
+				SpellCounts &byName = IndexEntry(ms->SpellResRef, false);
+				byName.memorized[i]++;
+				byName.charged[i] += charged;
+				// may grow indexCounts, so don't hold on to byName
+				SpellCounts &byNumber = IndexEntry(ms->SpellResRef, true);
+				byNumber.memorized[i]++;
+				byNumber.charged[i] += charged;
+				totalCharged += charged;
+			}
+		}
+	}
+	indexDirty = false;
+}
+
+Spellbook::SpellCounts &Spellbook::IndexEntry(const ieResRef resref, bool number) const
+{
+	const unsigned int *slot;
+	if (number) {
+		slot = numberIndex.get(atoi(resref+4));
+	} else {
+		slot = nameIndex.get(resref);
+	}
+	if (slot) {
+		return indexCounts[*slot];
+	}
+
+	unsigned int idx = (unsigned int) indexCounts.size();
+	if (number) {
+		numberIndex.set(atoi(resref+4), idx);
+	} else {
+		nameIndex.set(resref, idx);
+	}
+	indexCounts.resize(idx+1);
+	memset(&indexCounts[idx], 0, sizeof(SpellCounts));
+	return indexCounts[idx];
+}
+
+const Spellbook::SpellCounts *Spellbook::FindIndexEntry(const char *resref) const
+{
+	UpdateIndex();
+	const unsigned int *slot = nameIndex.get(resref);
+	return slot ? &indexCounts[*slot] : NULL;
+}
+
+const Spellbook::SpellCounts *Spellbook::FindIndexEntry(int spellid) const
+{
+	UpdateIndex();
+	const unsigned int *slot = numberIndex.get(spellid);
+	return slot ? &indexCounts[*slot] : NULL;
+}
+
 bool Spellbook::GetSpellInfo(SpellExtHeader *array, int type, int startindex, int count)
 {
 	memset(array, 0, count * sizeof(SpellExtHeader) );
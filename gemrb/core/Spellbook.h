@@ -32,6 +32,9 @@
 #include "ie_types.h"
 #include "win32def.h"
 
+#include "HashMap.h"
+#include "StringMap.h"
+
 #include <vector>
 
 namespace GemRB {
@@ -134,11 +137,27 @@ struct SpellExtHeader {
 
 class GEM_EXPORT Spellbook {
 private:
+	/** per type tallies of a single resref (or spell number) */
+	struct SpellCounts {
+		ieDword known[NUM_IWD2_SPELLTYPES];
+		ieDword memorized[NUM_IWD2_SPELLTYPES];
+		ieDword charged[NUM_IWD2_SPELLTYPES];
+	};
+
 	std::vector<CRESpellMemorization*> *spells;
 	std::vector<SpellExtHeader*> spellinfo;
 	int sorcerer;
 	int innate;
 
+	/* lookup index for the HaveSpell/KnowSpell/CountSpells family;
+	 * like spellinfo it is dropped by InvalidateSpells and rebuilt on demand */
+	mutable HashMap<std::string, unsigned int> nameIndex;
+	mutable HashMap<int, unsigned int> numberIndex;
+	mutable std::vector<SpellCounts> indexCounts;
+	mutable unsigned int totalKnown;
+	mutable unsigned int totalCharged;
+	mutable bool indexDirty;
+
 	/** Sets spell from memorized as 'already-cast' */
 	bool DepleteSpell(CREMemorizedSpell* spl);
 	/** Depletes a sorcerer type spellpage by one */
@@ -155,6 +174,13 @@ private:
 	bool AddKnownSpell(CREKnownSpell *spl, int memo);
 	/** Adds a new CRESpellMemorization, to the *end* only */
 	bool AddSpellMemorization(CRESpellMemorization* sm);
+	/** regenerates the lookup index if the book changed */
+	void UpdateIndex() const;
+	/** returns the index entry of a resref (or its spell number), adding it if needed */
+	SpellCounts &IndexEntry(const ieResRef resref, bool number) const;
+	/** looks up the index entry of a resref or spell number */
+	const SpellCounts *FindIndexEntry(const char *resref) const;
+	const SpellCounts *FindIndexEntry(int spellid) const;
 
 	bool HaveSpell(int spellid, int type, ieDword flags);
 	bool KnowSpell(int spellid, int type) const;
@@ -247,6 +273,10 @@ public:
 	/** invalidates the spellinfo list */
 	void ClearSpellInfo();
 
+	/** invalidates the spellinfo list and the spell lookup index, call it
+	after changing the spell pages directly */
+	void InvalidateSpells();
+
 	/** lists spells of a type */
 	bool GetSpellInfo(SpellExtHeader *array, int type, int startindex, int count);
 
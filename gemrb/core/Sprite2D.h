@@ -42,6 +42,16 @@ namespace GemRB {
 
 class AnimationFactory;
 
+/**
+ * Where a row of RLE pixel data starts: the offset of the code covering
+ * the first pixel of the row and how many pixels of that code (a run of
+ * transparent pixels) still belong to the previous row.
+ */
+struct RLERowOffset {
+	ieDword offset;
+	ieWord lead;
+};
+
 /**
  * @class Sprite2D
  * Class representing bitmap data.
@@ -79,6 +89,8 @@ public:
 	virtual void SetColorKey(ieDword) = 0;
 	virtual bool ConvertFormatTo(int /*bpp*/, ieDword /*rmask*/, ieDword /*gmask*/,
 							   ieDword /*bmask*/, ieDword /*amask*/) { return false; }; // not pure virtual!
+	/* GetRLERowIndex: one entry per row for RLE sprites, so they can be decoded from any row. NULL if unavailable. */
+	virtual const RLERowOffset* GetRLERowIndex() const { return NULL; }; // not pure virtual!
 	void acquire() { ++RefCount; }
 	void release();
 
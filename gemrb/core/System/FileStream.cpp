@@ -26,6 +26,8 @@
 
 namespace GemRB {
 
+#define WRITE_BUFFER_SIZE 16384
+
 #ifdef _DEBUG
 int FileStream::FileStreamPtrCount = 0;
 #endif
@@ -148,6 +150,8 @@ FileStream::FileStream(void)
 	opened = false;
 	created = false;
 	str = new File();
+	writeBuffer = NULL;
+	writeLength = 0;
 }
 
 DataStream* FileStream::Clone()
@@ -159,10 +163,26 @@ FileStream::~FileStream(void)
 {
 	Close();
 	delete str;
+	free(writeBuffer);
+}
+
+bool FileStream::Flush()
+{
+	if (!writeLength) {
+		return true;
+	}
+	size_t c = str->Write(writeBuffer, writeLength);
+	bool ret = c == writeLength;
+	writeLength = 0;
+	return ret;
 }
 
-void FileStream::Close()
+bool FileStream::Close()
 {
+	bool ret = Flush();
+	if (!ret) {
+		Log(ERROR, "FileStream", "Failed writing %s!", originalfile);
+	}
 	if (opened) {
 #ifdef _DEBUG
 		FileStreamPtrCount--;
@@ -171,6 +191,7 @@ void FileStream::Close()
 	}
 	opened = false;
 	created = false;
+	return ret;
 }
 
 void FileStream::FindLength()
@@ -263,6 +284,9 @@ int FileStream::Read(void* dest, unsigned int length)
 	if (Pos+length>size ) {
 		return GEM_ERROR;
 	}
+	if (!Flush()) {
+		return GEM_ERROR;
+	}
 	size_t c = str->Read(dest, length);
 	if (c != length) {
 		return GEM_ERROR;
@@ -281,15 +305,27 @@ int FileStream::Write(const void* src, unsigned int length)
 	}
 	// do encryption here if needed
 
-	size_t c = str->Write(src, length);
-	if (c != length) {
+	if (writeLength + length > WRITE_BUFFER_SIZE && !Flush()) {
 		return GEM_ERROR;
 	}
-	Pos += c;
+	if (length >= WRITE_BUFFER_SIZE) {
+		// too big to be worth copying
+		size_t c = str->Write(src, length);
+		if (c != length) {
+			return GEM_ERROR;
+		}
+	} else {
+		if (!writeBuffer) {
+			writeBuffer = (char *) malloc(WRITE_BUFFER_SIZE);
+		}
+		memcpy(writeBuffer + writeLength, src, length);
+		writeLength += length;
+	}
+	Pos += length;
 	if (Pos>size) {
 		size = Pos;
 	}
-	return c;
+	return length;
 }
 
 int FileStream::Seek(int newpos, int type)
@@ -297,6 +333,9 @@ int FileStream::Seek(int newpos, int type)
 	if (!opened && !created) {
 		return GEM_ERROR;
 	}
+	if (!Flush()) {
+		return GEM_ERROR;
+	}
 	switch (type) {
 		case GEM_STREAM_END:
 			str->SeekStart(size - newpos);
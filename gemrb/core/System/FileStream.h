@@ -48,6 +48,9 @@ private:
 	struct File;
 	File* str;
 	bool opened, created;
+	// writes are collected here, saving games writes a dword at a time
+	char* writeBuffer;
+	unsigned int writeLength;
 public:
 	FileStream(void);
 	~FileStream(void);
@@ -62,7 +65,8 @@ public:
 	int Write(const void* src, unsigned int length);
 	int Seek(int pos, int startpos);
 
-	void Close();
+	/** Flushes pending writes and closes the file, returns false if the flush failed */
+	bool Close();
 public:
 	/** Opens the specifed file.
 	 *
@@ -71,6 +75,7 @@ public:
 	static FileStream* OpenFile(const char* filename);
 private:
 	void FindLength();
+	bool Flush();
 };
 
 }
@@ -57,6 +57,11 @@ bool Logger::SetLogLevel(log_level level)
 	return false;
 }
 
+log_level Logger::GetLogLevel() const
+{
+	return myLevel;
+}
+
 void Logger::log(log_level level, const char* owner, const char* message, log_color color)
 {
 	if (level <= myLevel) {
@@ -59,6 +59,7 @@ public:
 	virtual void destroy();
 
 	bool SetLogLevel(log_level);
+	log_level GetLogLevel() const;
 	void log(log_level, const char* owner, const char* message, log_color color);
 protected:
 	virtual void LogInternal(log_level, const char*, const char*, log_color)=0;
@@ -18,6 +18,7 @@
 
 #include "System/Logging.h"
 
+#include "Holder.h"
 #include "System/Logger.h"
 #include "System/StringBuffer.h"
 
@@ -26,14 +27,71 @@
 #else
 #  include <cstdarg>
 #endif
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <string>
 #include <vector>
 
 namespace GemRB {
 
 static std::vector<Logger*> theLogger;
 
+// an owner logging more than this many DEBUG lines in a second
+// gets the rest of them dropped until the next second
+#define LOG_OWNER_RATE 100
+
+struct OwnerRate {
+	time_t second;
+	unsigned int count;
+	unsigned int dropped;
+};
+
+typedef std::vector<std::pair<std::string, unsigned int> > SuppressedList;
+
+static std::map<std::string, OwnerRate> ownerRates;
+static time_t ratesSecond = 0;
+
+// the audio backends log from their own threads, so the rate table is guarded
+// by a spinlock built on the atomic Holder counts: whoever raises it to 1 owns it
+static volatile HeldCount ratesLock = 0;
+#define LOCK_RATES() while (HELD_INCREMENT(ratesLock) != 1) { HELD_DECREMENT(ratesLock); }
+#define UNLOCK_RATES() HELD_DECREMENT(ratesLock)
+
+static void LogToAll(log_level level, const char* owner, const char* message, log_color color);
+
+// takes the drop counts of owners whose second is over (or all of them), call it locked
+static void CollectSuppressed(time_t now, bool all, SuppressedList& suppressed)
+{
+	std::map<std::string, OwnerRate>::iterator it;
+	for (it = ownerRates.begin(); it != ownerRates.end(); ++it) {
+		OwnerRate& rate = it->second;
+		if (rate.dropped && (all || rate.second != now)) {
+			suppressed.push_back(std::make_pair(it->first, rate.dropped));
+			rate.dropped = 0;
+		}
+	}
+}
+
+// call it unlocked, the loggers may take their time
+static void ReportSuppressed(const SuppressedList& suppressed)
+{
+	for (size_t i = 0; i < suppressed.size(); ++i) {
+		char msg[48];
+		snprintf(msg, sizeof(msg), "%u messages suppressed", suppressed[i].second);
+		LogToAll(WARNING, suppressed[i].first.c_str(), msg, YELLOW);
+	}
+}
+
 void ShutdownLogging()
 {
+	SuppressedList suppressed;
+	LOCK_RATES();
+	CollectSuppressed(0, true, suppressed);
+	ownerRates.clear();
+	UNLOCK_RATES();
+	ReportSuppressed(suppressed);
+
 	for (size_t i = 0; i < theLogger.size(); ++i) {
 		theLogger[i]->destroy();
 	}
@@ -67,33 +125,87 @@ void RemoveLogger(Logger* logger)
 	}
 }
 
+static void LogToAll(log_level level, const char* owner, const char* message, log_color color)
+{
+	for (size_t i = 0; i < theLogger.size(); ++i) {
+		theLogger[i]->log(level, owner, message, color);
+	}
+}
+
+// check the levels before doing any formatting
+static bool WantLevel(log_level level)
+{
+#ifdef DISABLE_DEBUG_LOGGING
+	if (level == DEBUG)
+		return false;
+#endif
+	for (size_t i = 0; i < theLogger.size(); ++i) {
+		if (level <= theLogger[i]->GetLogLevel())
+			return true;
+	}
+	return false;
+}
+
+// only DEBUG lines are limited, the rest never touch the clock or the lock
+static bool RateLimited(log_level level, const char* owner)
+{
+	if (level < DEBUG)
+		return false;
+
+	time_t now = time(NULL);
+	bool limited = false;
+	SuppressedList suppressed;
+
+	LOCK_RATES();
+	// report floods that stopped on the next DEBUG line of anyone, not just their owner
+	if (ratesSecond != now) {
+		CollectSuppressed(now, false, suppressed);
+		ratesSecond = now;
+	}
+	OwnerRate& rate = ownerRates[owner];
+	if (rate.second != now) {
+		rate.second = now;
+		rate.count = 0;
+	}
+	if (++rate.count > LOG_OWNER_RATE) {
+		rate.dropped++;
+		limited = true;
+	}
+	UNLOCK_RATES();
+
+	ReportSuppressed(suppressed);
+	return limited;
+}
+
 static void vLog(log_level level, const char* owner, const char* message, log_color color, va_list ap)
 {
-	if (theLogger.empty())
+	if (!WantLevel(level) || RateLimited(level, owner))
 		return;
 
-	// Copied from System/StringBuffer.cpp
+	// format once into the stack buffer, only long messages need a second pass
+	char stackbuf[1024];
+	char* buf = stackbuf;
 #ifndef __va_copy
-	// Don't try to be smart.
-	// Assume this is long enough. If not, message will be truncated.
 	// MSVC6 has old vsnprintf that doesn't give length
-	const size_t len = 4095;
+	// the message will be truncated if it doesn't fit
+	vsnprintf(stackbuf, sizeof(stackbuf), message, ap);
+	stackbuf[sizeof(stackbuf) - 1] = 0;
 #else
-    va_list ap_copy;
-    // __va_copy should always be defined
-    // va_copy is only defined by C99 (C++11 and up)
-    __va_copy(ap_copy, ap);
-    const size_t len = vsnprintf(NULL, 0, message, ap_copy);
-    va_end(ap_copy);
+	va_list ap_copy;
+	// __va_copy should always be defined
+	// va_copy is only defined by C99 (C++11 and up)
+	__va_copy(ap_copy, ap);
+	int len = vsnprintf(stackbuf, sizeof(stackbuf), message, ap_copy);
+	va_end(ap_copy);
+	if (len >= (int) sizeof(stackbuf)) {
+		buf = (char *) malloc(len + 1);
+		vsnprintf(buf, len + 1, message, ap);
+	}
 #endif
 
-#if defined(__GNUC__)
-	__extension__ // Variable-length arrays
-#endif
-	char buf[len+1];
-	vsnprintf(buf, len + 1, message, ap);
-	for (size_t i = 0; i < theLogger.size(); ++i) {
-		theLogger[i]->log(level, owner, buf, color);
+	LogToAll(level, owner, buf, color);
+	if (buf != stackbuf) {
+		free(buf);
 	}
 }
 
@@ -127,9 +239,9 @@ void Log(log_level level, const char* owner, const char* message, ...)
 
 void Log(log_level level, const char* owner, StringBuffer const& buffer)
 {
-	for (size_t i = 0; i < theLogger.size(); ++i) {
-		theLogger[i]->log(level, owner, buffer.get().c_str(), WHITE);
-	}
+	if (!WantLevel(level) || RateLimited(level, owner))
+		return;
+	LogToAll(level, owner, buffer.get().c_str(), WHITE);
 }
 
 }
@@ -100,4 +100,25 @@ int MemoryStream::Seek(int newpos, int type)
 	return GEM_OK;
 }
 
+DataStream* LoadIntoMemory(DataStream* str)
+{
+	if (!str || dynamic_cast<MemoryStream*>(str)) {
+		return str;
+	}
+	unsigned long pos = str->GetPos();
+	unsigned long length = str->Size();
+	str->Rewind();
+	char *data = (char *) malloc(length);
+	if (!data || str->Read(data, length) != (int) length) {
+		// keep using the original, it will report its own errors
+		free(data);
+		str->Seek(pos, GEM_STREAM_START);
+		return str;
+	}
+	MemoryStream *mem = new MemoryStream(str->originalfile, data, length);
+	mem->Seek(pos, GEM_STREAM_START);
+	delete str;
+	return mem;
+}
+
 }
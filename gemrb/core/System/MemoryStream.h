@@ -41,6 +41,11 @@ public:
 	int Seek(int pos, int startpos);
 };
 
+/** Reads the rest of str into memory (unless it is already there) and
+ * returns that in its place, so many small reads become plain copies.
+ * Takes ownership of str. */
+GEM_EXPORT DataStream* LoadIntoMemory(DataStream* str);
+
 }
 
 #endif
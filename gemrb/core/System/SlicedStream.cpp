@@ -100,7 +100,8 @@ int SlicedStream::Seek(int newpos, int type)
 
 DataStream* SliceStream(DataStream* str, unsigned long startpos, unsigned long size, bool preservepos)
 {
-	if (size <= 16384) {
+	// a SlicedStream clones its parent, which for a MemoryStream copies all of it
+	if (size <= 16384 || dynamic_cast<MemoryStream*>(str)) {
 		// small (or empty) substream, just read it into a buffer instead of expensive file I/O
 		unsigned long oldpos;
 		if (preservepos)
@@ -34,12 +34,17 @@ TileMap::TileMap(void)
 	XCellCount = 0;
 	YCellCount = 0;
 	LargeMap = !core->HasFeature(GF_SMALL_FOG);
+	objectIndex.init(257, 64);
 }
 
 TileMap::~TileMap(void)
 {
 	size_t i;
 
+#ifdef HASHMAP_DEBUG
+	objectIndex.dumpStats("area objects by global ID");
+#endif
+
 	for (i = 0; i < overlays.size(); i++) {
 		delete( overlays[i] );
 	}
@@ -108,6 +113,15 @@ Door* TileMap::AddDoor(const char *ID, const char* Name, unsigned int Flags,
 	door->SetName( ID );
 	door->SetScriptName( Name );
 	doors.push_back( door );
+	objectIndex.set( door->GetGlobalID(), door );
+	// index both states, so opening and closing needs no reindexing
+	const Region& ob = open->BBox;
+	const Region& cb = closed->BBox;
+	int x1 = std::min(ob.x, cb.x);
+	int y1 = std::min(ob.y, cb.y);
+	int x2 = std::max(ob.x + ob.w, cb.x + cb.w);
+	int y2 = std::max(ob.y + ob.h, cb.y + cb.h);
+	doorGrid.Insert( door, Region(x1, y1, x2 - x1, y2 - y1) );
 	return door;
 }
 
@@ -121,10 +135,11 @@ Door* TileMap::GetDoor(unsigned int idx) const
 
 Door* TileMap::GetDoor(const Point &p) const
 {
-	for (size_t i = 0; i < doors.size(); i++) {
+	const std::vector<Door*>& candidates = doorGrid.Query(p);
+	for (size_t i = 0; i < candidates.size(); i++) {
 		Gem_Polygon *doorpoly;
 
-		Door* door = doors[i];
+		Door* door = candidates[i];
 		if (door->Flags&DOOR_HIDDEN) {
 			continue;
 		}
@@ -419,6 +434,8 @@ void TileMap::DrawFogOfWar(ieByte* explored_mask, ieByte* visible_mask, Region v
 void TileMap::AddContainer(Container *c)
 {
 	containers.push_back(c);
+	objectIndex.set(c->GetGlobalID(), c);
+	containerGrid.Insert(c, c->outline->BBox);
 }
 
 Container* TileMap::GetContainer(unsigned int idx) const
@@ -444,8 +461,9 @@ Container* TileMap::GetContainer(const char* Name) const
 //in this case, empty piles won't be found!
 Container* TileMap::GetContainer(const Point &position, int type) const
 {
-	for (size_t i = 0; i < containers.size(); i++) {
-		Container* c = containers[i];
+	const std::vector<Container*>& candidates = containerGrid.Query(position);
+	for (size_t i = 0; i < candidates.size(); i++) {
+		Container* c = candidates[i];
 		if (type!=-1) {
 			if (c->Type!=type) {
 				continue;
@@ -513,6 +531,8 @@ int TileMap::CleanupContainer(Container *container)
 	for (size_t i = 0; i < containers.size(); i++) {
 		if (containers[i]==container) {
 			containers.erase(containers.begin()+i);
+			objectIndex.remove(container->GetGlobalID());
+			containerGrid.Remove(container);
 			delete container;
 			return 1;
 		}
@@ -522,6 +542,12 @@ int TileMap::CleanupContainer(Container *container)
 	return 1;
 }
 
+Scriptable* TileMap::GetScriptableByGlobalID(ieDword objectID) const
+{
+	Scriptable* const* scr = objectIndex.get(objectID);
+	return scr ? *scr : NULL;
+}
+
 //infopoints
 InfoPoint* TileMap::AddInfoPoint(const char* Name, unsigned short Type,
 	Gem_Polygon* outline)
@@ -548,14 +574,17 @@ InfoPoint* TileMap::AddInfoPoint(const char* Name, unsigned short Type,
 	ip->outline = outline;
 	//ip->Active = true; //set active on creation
 	infoPoints.push_back( ip );
+	objectIndex.set( ip->GetGlobalID(), ip );
+	infoPointGrid.Insert( ip, outline->BBox );
 	return ip;
 }
 
 //if detectable is set, then only detectable infopoints will be returned
 InfoPoint* TileMap::GetInfoPoint(const Point &p, bool detectable) const
 {
-	for (size_t i = 0; i < infoPoints.size(); i++) {
-		InfoPoint* ip = infoPoints[i];
+	const std::vector<InfoPoint*>& candidates = infoPointGrid.Query(p);
+	for (size_t i = 0; i < candidates.size(); i++) {
+		InfoPoint* ip = candidates[i];
 		//these flags disable any kind of user interaction
 		//scripts can still access an infopoint by name
 		if (ip->Flags&(INFO_DOOR|TRAP_DEACTIVATED) )
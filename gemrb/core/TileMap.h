@@ -23,7 +23,9 @@
 
 #include "exports.h"
 
+#include "HashMap.h"
 #include "Polygon.h"
+#include "SpatialGrid.h"
 #include "TileOverlay.h"
 
 namespace GemRB {
@@ -34,6 +36,7 @@ namespace GemRB {
 class Container;
 class Door;
 class InfoPoint;
+class Scriptable;
 class TileObject;
 
 class GEM_EXPORT TileMap {
@@ -44,6 +47,12 @@ private:
 	std::vector< Container*> containers;
 	std::vector< InfoPoint*> infoPoints;
 	std::vector< TileObject*> tiles;
+	// spatial indices for the click target lookups by position
+	SpatialGrid<Door> doorGrid;
+	SpatialGrid<Container> containerGrid;
+	SpatialGrid<InfoPoint> infoPointGrid;
+	// doors, containers and infopoints by global ID
+	HashMap<ieDword, Scriptable*> objectIndex;
 	bool LargeMap;
 public:
 	TileMap(void);
@@ -83,6 +92,9 @@ public:
 	InfoPoint* AdjustNearestTravel(Point &p);
 	size_t GetInfoPointCount() const { return infoPoints.size(); }
 
+	/* door, container or infopoint with this global ID */
+	Scriptable* GetScriptableByGlobalID(ieDword objectID) const;
+
 	TileObject* AddTile(const char* ID, const char* Name, unsigned int Flags,
 		unsigned short* openindices, int opencount,unsigned short* closeindices, int closecount);
 	TileObject* GetTile(unsigned int idx);
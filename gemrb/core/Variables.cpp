@@ -27,26 +27,16 @@ namespace GemRB {
 
 /////////////////////////////////////////////////////////////////////////////
 // private inlines 
-inline bool Variables::MyCopyKey(char*& dest, const char* key) const
+inline void Variables::MyCopyKey(char* dest, const char* key) const
 {
 	int i, j;
 
-	//use j
-	for (i = 0,j = 0; key[i] && j < MAX_VARIABLE_LENGTH - 1; i++)
-		if (key[i] != ' ') {
-			j++;
-		}
-	dest = (char *) malloc(j + 1);
-	if (!dest) {
-		return false;
-	}
 	for (i = 0,j = 0; key[i] && j < MAX_VARIABLE_LENGTH - 1; i++) {
 		if (key[i] != ' ') {
 			dest[j++] = (char) tolower( key[i] );
 		}
 	}
 	dest[j] = 0;
-	return true;
 }
 
 inline unsigned int Variables::MyCompareKey(const char* key, const char *str) const
@@ -162,10 +152,6 @@ void Variables::RemoveAll(ReleaseFun fun)
 						pAssoc->Value.sValue = NULL;
 					}
 				}
-				if (pAssoc->key) {
-					free(pAssoc->key);
-					pAssoc->key = NULL;
-				}
 			}
 		}
 	}
@@ -216,11 +202,8 @@ Variables::MyAssoc* Variables::NewAssoc(const char* key)
 	} else {
 		int len;
 		len = strnlen( key, MAX_VARIABLE_LENGTH - 1 );
-		pAssoc->key = (char *) malloc(len + 1);
-		if (pAssoc->key) {
-			memcpy( pAssoc->key, key, len );
-			pAssoc->key[len] = 0;
-		}
+		memcpy( pAssoc->key, key, len );
+		pAssoc->key[len] = 0;
 	}
 #ifdef _DEBUG
 	pAssoc->Value.nValue = 0xcccccccc; //invalid value
@@ -229,12 +212,49 @@ Variables::MyAssoc* Variables::NewAssoc(const char* key)
 	return pAssoc;
 }
 
-void Variables::FreeAssoc(Variables::MyAssoc* pAssoc)
+// creates a new association for a key that isn't in the table yet
+Variables::MyAssoc* Variables::InsertAssoc(const char* key, unsigned int nFullHash)
+{
+	if (m_pHashTable == NULL) {
+		InitHashTable( m_nHashTableSize );
+	} else if ((unsigned int) m_nCount >= 2 * m_nHashTableSize) {
+		// keep the chains short (smaller tables never grow, so
+		// their iteration order is the same as it always was)
+		GrowHashTable();
+	}
+
+	Variables::MyAssoc* pAssoc = NewAssoc( key );
+	unsigned int nHash = nFullHash % m_nHashTableSize;
+	pAssoc->nHashValue = nHash;
+	pAssoc->nFullHash = nFullHash;
+	pAssoc->pNext = m_pHashTable[nHash];
+	m_pHashTable[nHash] = pAssoc;
+	return pAssoc;
+}
+
+void Variables::GrowHashTable()
 {
-	if (pAssoc->key) {
-		free(pAssoc->key);
-		pAssoc->key = NULL;
+	unsigned int nOldSize = m_nHashTableSize;
+	Variables::MyAssoc** pOldTable = m_pHashTable;
+
+	m_nHashTableSize = nOldSize * 2 + 1;
+	m_pHashTable = (Variables::MyAssoc **) calloc(m_nHashTableSize, sizeof(Variables::MyAssoc *));
+	for (unsigned int nBucket = 0; nBucket < nOldSize; nBucket++) {
+		Variables::MyAssoc* pAssoc = pOldTable[nBucket];
+		while (pAssoc) {
+			Variables::MyAssoc* pNext = pAssoc->pNext;
+			unsigned int nHash = pAssoc->nFullHash % m_nHashTableSize;
+			pAssoc->nHashValue = nHash;
+			pAssoc->pNext = m_pHashTable[nHash];
+			m_pHashTable[nHash] = pAssoc;
+			pAssoc = pNext;
+		}
 	}
+	free(pOldTable);
+}
+
+void Variables::FreeAssoc(Variables::MyAssoc* pAssoc)
+{
 	pAssoc->pNext = m_pFreeList;
 	m_pFreeList = pAssoc;
 	m_nCount--;
@@ -246,10 +266,10 @@ void Variables::FreeAssoc(Variables::MyAssoc* pAssoc)
 	}
 }
 
-Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nHash) const
+Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nFullHash) const
 	// find association (or return NULL)
 {
-	nHash = MyHashKey( key ) % m_nHashTableSize;
+	nFullHash = MyHashKey( key );
 
 	if (m_pHashTable == NULL) {
 		return NULL;
@@ -257,9 +277,12 @@ Variables::MyAssoc* Variables::GetAssocAt(const char* key, unsigned int& nHash)
 
 	// see if it exists
 	Variables::MyAssoc* pAssoc;
-	for (pAssoc = m_pHashTable[nHash];
+	for (pAssoc = m_pHashTable[nFullHash % m_nHashTableSize];
 		pAssoc != NULL;
 		pAssoc = pAssoc->pNext) {
+		if (pAssoc->nFullHash != nFullHash) {
+			continue;
+		}
 		if (m_lParseKey) {
 			if (!MyCompareKey( pAssoc->key, key) ) {
 				return pAssoc;
@@ -367,14 +390,8 @@ void Variables::SetAt(const char* key, char* value)
 
 	assert( m_type == GEM_VARIABLES_STRING );
 	if (( pAssoc = GetAssocAt( key, nHash ) ) == NULL) {
-		if (m_pHashTable == NULL)
-			InitHashTable( m_nHashTableSize );
-
 		// it doesn't exist, add a new Association
-		pAssoc = NewAssoc( key );
-		// put into hash table
-		pAssoc->pNext = m_pHashTable[nHash];
-		m_pHashTable[nHash] = pAssoc;
+		pAssoc = InsertAssoc( key, nHash );
 	} else {
 		if (pAssoc->Value.sValue) {
 			free( pAssoc->Value.sValue );
@@ -382,11 +399,7 @@ void Variables::SetAt(const char* key, char* value)
 		}
 	}
 
-	//set value only if we have a key
-	if (pAssoc->key) {
-		pAssoc->Value.sValue = value;
-		pAssoc->nHashValue = nHash;
-	}
+	pAssoc->Value.sValue = value;
 }
 
 void Variables::SetAt(const char* key, void* value)
@@ -396,14 +409,8 @@ void Variables::SetAt(const char* key, void* value)
 
 	assert( m_type == GEM_VARIABLES_POINTER );
 	if (( pAssoc = GetAssocAt( key, nHash ) ) == NULL) {
-		if (m_pHashTable == NULL)
-			InitHashTable( m_nHashTableSize );
-
 		// it doesn't exist, add a new Association
-		pAssoc = NewAssoc( key );
-		// put into hash table
-		pAssoc->pNext = m_pHashTable[nHash];
-		m_pHashTable[nHash] = pAssoc;
+		pAssoc = InsertAssoc( key, nHash );
 	} else {
 		if (pAssoc->Value.sValue) {
 			free( pAssoc->Value.sValue );
@@ -411,12 +418,7 @@ void Variables::SetAt(const char* key, void* value)
 		}
 	}
 
-	//set value only if we have a key
-	if (pAssoc->key) {
-		pAssoc->Value.pValue = value;
-		pAssoc->nHashValue = nHash;
-	}
-
+	pAssoc->Value.pValue = value;
 }
 
 
@@ -432,20 +434,10 @@ void Variables::SetAt(const char* key, ieDword value, bool nocreate)
 			return;
 		}
 
-		if (m_pHashTable == NULL)
-			InitHashTable( m_nHashTableSize );
-
 		// it doesn't exist, add a new Association
-		pAssoc = NewAssoc( key );
-		// put into hash table
-		pAssoc->pNext = m_pHashTable[nHash];
-		m_pHashTable[nHash] = pAssoc;
-	}
-	//set value only if we have a key
-	if (pAssoc->key) {
-		pAssoc->Value.nValue = value;
-		pAssoc->nHashValue = nHash;
+		pAssoc = InsertAssoc( key, nHash );
 	}
+	pAssoc->Value.nValue = value;
 }
 
 void Variables::Remove(const char* key)
@@ -456,6 +448,7 @@ void Variables::Remove(const char* key)
 	pAssoc = GetAssocAt( key, nHash );
 	if (!pAssoc) return; // not in there
 
+	nHash = pAssoc->nHashValue;
 	if (pAssoc == m_pHashTable[nHash]) {
 		// head
 		m_pHashTable[nHash] = pAssoc->pNext;
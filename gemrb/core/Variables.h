@@ -44,13 +44,15 @@ protected:
 	// Association
 	class MyAssoc {
 		MyAssoc* pNext;
-		char* key;
+		// keys are short, so they are kept inline instead of allocated
+		char key[MAX_VARIABLE_LENGTH];
 		union {
 			ieDword nValue;
 			char* sValue;
 			void* pValue;
 		} Value;
-		unsigned long nHashValue;
+		unsigned long nHashValue; // bucket
+		unsigned int nFullHash; // unreduced hash, checked before comparing keys
 		friend class Variables;
 	};
 	struct MemBlock {
@@ -121,9 +123,11 @@ protected:
 	int m_type; //could be string or ieDword 
 
 	Variables::MyAssoc* NewAssoc(const char* key);
+	Variables::MyAssoc* InsertAssoc(const char* key, unsigned int nFullHash);
 	void FreeAssoc(Variables::MyAssoc*);
+	void GrowHashTable();
 	Variables::MyAssoc* GetAssocAt(const char*, unsigned int&) const;
-	inline bool MyCopyKey(char*& dest, const char* key) const;
+	inline void MyCopyKey(char* dest, const char* key) const;
 	inline unsigned int MyCompareKey(const char* key, const char *str) const;
 	inline unsigned int MyHashKey(const char*) const;
 
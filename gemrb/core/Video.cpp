@@ -343,6 +343,37 @@ Region Video::GetViewport() const
 	return Viewport;
 }
 
+// the batched primitives below are plain loops over the single primitive
+// calls; drivers override them to set up (lock, clip, map colors) only once
+void Video::DrawPoints(const Point* points, const Color* colors, unsigned int count, bool clipped)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		SetPixel(points[i].x, points[i].y, colors[i], clipped);
+	}
+}
+
+void Video::DrawCircles(const Point* centers, const Color* colors, unsigned int count,
+	unsigned short r, bool clipped)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		DrawCircle(centers[i].x, centers[i].y, r, colors[i], clipped);
+	}
+}
+
+void Video::DrawLines(const Point* points, const Color* colors, unsigned int count, bool clipped)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		DrawLine(points[2*i].x, points[2*i].y, points[2*i+1].x, points[2*i+1].y, colors[i], clipped);
+	}
+}
+
+void Video::DrawRects(const Region* rgns, unsigned int count, const Color& color)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		DrawRect(rgns[i], color);
+	}
+}
+
 void Video::SetMovieFont(Font *stfont, Palette *pal)
 {
 	subtitlefont = stfont;
@@ -130,7 +130,7 @@ public:
 
 	void InitSpriteCover(SpriteCover* sc, int flags);
 	void AddPolygonToSpriteCover(SpriteCover* sc, Wall_Polygon* poly);
-	void DestroySpriteCover(SpriteCover* sc);
+	virtual void DestroySpriteCover(SpriteCover* sc);
 
 	virtual Sprite2D* CreateSprite(int w, int h, int bpp, ieDword rMask,
 		ieDword gMask, ieDword bMask, ieDword aMask, void* pixels,
@@ -177,6 +177,15 @@ public:
 	/** Draws a line segment */
 	virtual void DrawLine(short x1, short y1, short x2, short y2,
 		const Color& color, bool clipped = false) = 0;
+	/** Draws a batch of pixels, each point with its own color */
+	virtual void DrawPoints(const Point* points, const Color* colors, unsigned int count, bool clipped = true);
+	/** Draws a batch of same sized circles, each with its own color */
+	virtual void DrawCircles(const Point* centers, const Color* colors, unsigned int count,
+		unsigned short r, bool clipped = true);
+	/** Draws a batch of line segments, points holds 2*count endpoints */
+	virtual void DrawLines(const Point* points, const Color* colors, unsigned int count, bool clipped = false);
+	/** Fills a batch of rectangles with the same color */
+	virtual void DrawRects(const Region* rgns, unsigned int count, const Color& color);
 	/** Blits a Sprite filling the Region */
 	void BlitTiled(Region rgn, const Sprite2D* img, bool anchor = false);
 	/** Sets Event Manager */
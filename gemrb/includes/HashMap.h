@@ -121,6 +121,7 @@ private:
 	struct Debug {
 		unsigned int allocs;
 		unsigned int accesses;
+		unsigned int hits;
 	};
 
 	mutable Debug _debug;
@@ -232,8 +233,12 @@ const Value *HashMap<Key, Value, Hash>::get(const Key &key) const
 	incAccesses();
 
 	for (Entry *e = getBucketByKey(key); e; e = e->next)
-		if (Hash::equals(e->key, key))
+		if (Hash::equals(e->key, key)) {
+#ifdef HASHMAP_DEBUG
+			_debug.hits++;
+#endif
 			return &e->value;
+		}
 
 	return NULL;
 }
@@ -283,10 +288,6 @@ void HashMap<Key, Value, Hash>::clear()
 	if (!isInitialized())
 		return;
 
-#ifdef HASHMAP_DEBUG
-	dumpStats();
-#endif
-
 	_available = NULL;
 
 	delete[] _buckets;
@@ -435,6 +436,7 @@ void HashMap<Key, Value, Hash>::dumpStats(const char* description)
 			"size\t\t%u\n"
 			"allocs\t\t%u\n"
 			"accesses\t%u\n"
+			"hits\t\t%u\n"
 			"entries\t\t%u\n"
 			"collisions\t%u\n"
 			"empty buckets\t%u\n"
@@ -446,7 +448,7 @@ void HashMap<Key, Value, Hash>::dumpStats(const char* description)
 			"largest bucket\t%u\n"
 			"memsize\t\t%ukb\n",
 			description,
-			_tableSize, _debug.allocs, _debug.accesses,
+			_tableSize, _debug.allocs, _debug.accesses, _debug.hits,
 			entries, collisions, empty, eq1, eq2, gt2,
 			gt4, gt8, largest, bytes / 1024);
 
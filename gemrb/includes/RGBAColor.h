@@ -34,6 +34,13 @@ struct Color {
 		tint.g = (tint.g * tintMod->g) >> 8;
 		tint.b = (tint.b * tintMod->b) >> 8;
 	}
+
+	bool operator==(const Color& other) const {
+		return r == other.r && g == other.g && b == other.b && a == other.a;
+	}
+	bool operator!=(const Color& other) const {
+		return !(*this == other);
+	}
 }
 #ifdef __GNUC__
 	__attribute__((aligned(4)))
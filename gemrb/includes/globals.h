@@ -212,6 +212,25 @@ inline unsigned long GetTickCount()
 }
 #endif
 
+/** microsecond clock for profiling, GetTickCount is too coarse to time parts of a tick */
+inline unsigned __int64 GetMicroTicks()
+{
+#ifdef WIN32
+	static LARGE_INTEGER freq = { { 0, 0 } };
+	if (!freq.QuadPart) {
+		QueryPerformanceFrequency(&freq);
+	}
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	// split up, so the multiplication can't overflow
+	return (now.QuadPart / freq.QuadPart) * 1000000 + (now.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_usec + (unsigned __int64) tv.tv_sec * 1000000;
+#endif
+}
+
 inline bool valid_number(const char* string, long& val)
 {
 	char* endpr;
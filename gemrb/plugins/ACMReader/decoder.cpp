@@ -29,6 +29,10 @@ int CSubbandDecoder::init_decoder()
 		memory_buffer = ( int * ) calloc( memory_size, sizeof( int ) );
 		if (!memory_buffer)
 			return 0;
+		// two values for each column of the widest subband
+		state_buffer = ( int * ) calloc( block_size, sizeof( int ) );
+		if (!state_buffer)
+			return 0;
 	}
 	return 1;
 }
@@ -61,7 +65,7 @@ void CSubbandDecoder::decode_data(int* buffer, int blocks)
 void CSubbandDecoder::sub_4d3fcc(short* memory, int* buffer, int sb_size,
 	int blocks)
 {
-	int row_0, row_1, row_2 = 0, row_3 = 0, db_0, db_1;
+	int row_0, row_1, row_2 = 0, row_3 = 0;
 	int i;
 	int sb_size_2 = sb_size * 2, sb_size_3 = sb_size * 3;
 	if (blocks == 2) {
@@ -95,44 +99,35 @@ void CSubbandDecoder::sub_4d3fcc(short* memory, int* buffer, int sb_size,
 			buffer++;
 		}
 	} else {
+		int* db_0 = state_buffer, * db_1 = state_buffer + sb_size;
 		for (i = 0; i < sb_size; i++) {
-			int* buff_ptr = buffer;
-			if (( blocks >> 1 ) & 1) {
-				row_0 = buff_ptr[0];
-				row_1 = buff_ptr[sb_size];
-
-				buff_ptr[0] = memory[0] + 2 * memory[1] + row_0;
-				buff_ptr[sb_size] = -memory[1] + 2 * row_0 - row_1;
-				buff_ptr += sb_size_2;
-
-				db_0 = row_0;
-				db_1 = row_1;
-			} else {
-				db_0 = memory[0];
-				db_1 = memory[1];
-			}
+			db_0[i] = memory[i * 2];
+			db_1[i] = memory[i * 2 + 1];
+		}
+		if (( blocks >> 1 ) & 1) {
+			for (i = 0; i < sb_size; i++) {
+				row_0 = buffer[i];
+				row_1 = buffer[sb_size + i];
 
-			for (int j = 0; j < blocks >> 2; j++) {
-				row_0 = buff_ptr[0];  buff_ptr[0] = db_0 + 2 * db_1 + row_0;  buff_ptr += sb_size;
-				row_1 = buff_ptr[0];  buff_ptr[0] = -db_1 + 2 * row_0 - row_1;  buff_ptr += sb_size;
-				row_2 = buff_ptr[0];  buff_ptr[0] = row_0 + 2 * row_1 + row_2;  buff_ptr += sb_size;
-				row_3 = buff_ptr[0];  buff_ptr[0] = -row_1 + 2 * row_2 -
-					row_3;  buff_ptr += sb_size;
+				buffer[i] = db_0[i] + 2 * db_1[i] + row_0;
+				buffer[sb_size + i] = -db_1[i] + 2 * row_0 - row_1;
 
-				db_0 = row_2;
-				db_1 = row_3;
+				db_0[i] = row_0;
+				db_1[i] = row_1;
 			}
-			memory[0] = ( short ) row_2;
-			memory[1] = ( short ) row_3;
-			memory += 2;
-			buffer++;
+			buffer += sb_size_2;
+		}
+		reconstruct_rows( buffer, sb_size, blocks >> 2, db_0, db_1 );
+		for (i = 0; i < sb_size; i++) {
+			memory[i * 2] = ( short ) db_0[i];
+			memory[i * 2 + 1] = ( short ) db_1[i];
 		}
 	}
 }
 void CSubbandDecoder::sub_4d420c(int* memory, int* buffer, int sb_size,
 	int blocks)
 {
-	int row_0, row_1, row_2 = 0, row_3 = 0, db_0, db_1;
+	int row_0, row_1, row_2 = 0, row_3 = 0;
 	int i;
 	int sb_size_2 = sb_size * 2, sb_size_3 = sb_size * 3;
 	if (blocks == 4) {
@@ -154,24 +149,70 @@ void CSubbandDecoder::sub_4d420c(int* memory, int* buffer, int sb_size,
 			buffer++;
 		}
 	} else {
+		int* db_0 = state_buffer, * db_1 = state_buffer + sb_size;
+		for (i = 0; i < sb_size; i++) {
+			db_0[i] = memory[i * 2];
+			db_1[i] = memory[i * 2 + 1];
+		}
+		reconstruct_rows( buffer, sb_size, blocks >> 2, db_0, db_1 );
 		for (i = 0; i < sb_size; i++) {
-			int* buff_ptr = buffer;
-			db_0 = memory[0]; db_1 = memory[1];
-			for (int j = 0; j < blocks >> 2; j++) {
-				row_0 = buff_ptr[0];  buff_ptr[0] = db_0 + 2 * db_1 + row_0;  buff_ptr += sb_size;
-				row_1 = buff_ptr[0];  buff_ptr[0] = -db_1 + 2 * row_0 - row_1;  buff_ptr += sb_size;
-				row_2 = buff_ptr[0];  buff_ptr[0] = row_0 + 2 * row_1 + row_2;  buff_ptr += sb_size;
-				row_3 = buff_ptr[0];  buff_ptr[0] = -row_1 + 2 * row_2 -
+			memory[i * 2] = db_0[i];
+			memory[i * 2 + 1] = db_1[i];
+		}
+	}
+}
+
+// The columns of a subband are independent of each other, so instead of
+// walking down one column at a time (striding through the whole buffer with
+// a power of two step, which thrashes the cache for wide subbands), go over
+// it row by row. The inner loop is then over contiguous memory without
+// branches, which the compiler can vectorize.
+// Narrow subbands are still done a column at a time, keeping the state in
+// registers is cheaper for them.
+#define ROW_ORDER_MIN_WIDTH 32
+
+void CSubbandDecoder::reconstruct_rows(int* buffer, int sb_size, int groups,
+	int* db_0, int* db_1)
+{
+	if (sb_size < ROW_ORDER_MIN_WIDTH) {
+		for (int i = 0; i < sb_size; i++) {
+			int* buff_ptr = buffer + i;
+			int state_0 = db_0[i], state_1 = db_1[i];
+			for (int j = 0; j < groups; j++) {
+				int row_0 = buff_ptr[0];  buff_ptr[0] = state_0 + 2 * state_1 + row_0;  buff_ptr += sb_size;
+				int row_1 = buff_ptr[0];  buff_ptr[0] = -state_1 + 2 * row_0 - row_1;  buff_ptr += sb_size;
+				int row_2 = buff_ptr[0];  buff_ptr[0] = row_0 + 2 * row_1 + row_2;  buff_ptr += sb_size;
+				int row_3 = buff_ptr[0];  buff_ptr[0] = -row_1 + 2 * row_2 -
 					row_3;  buff_ptr += sb_size;
 
-				db_0 = row_2;
-				db_1 = row_3;
+				state_0 = row_2;
+				state_1 = row_3;
 			}
-			memory[0] = row_2;
-			memory[1] = row_3;
+			db_0[i] = state_0;
+			db_1[i] = state_1;
+		}
+		return;
+	}
 
-			memory += 2;
-			buffer++;
+	for (int j = 0; j < groups; j++) {
+		int* row_ptr_0 = buffer;
+		int* row_ptr_1 = row_ptr_0 + sb_size;
+		int* row_ptr_2 = row_ptr_1 + sb_size;
+		int* row_ptr_3 = row_ptr_2 + sb_size;
+		for (int i = 0; i < sb_size; i++) {
+			int row_0 = row_ptr_0[i];
+			int row_1 = row_ptr_1[i];
+			int row_2 = row_ptr_2[i];
+			int row_3 = row_ptr_3[i];
+
+			row_ptr_0[i] = db_0[i] + 2 * db_1[i] + row_0;
+			row_ptr_1[i] = -db_1[i] + 2 * row_0 - row_1;
+			row_ptr_2[i] = row_0 + 2 * row_1 + row_2;
+			row_ptr_3[i] = -row_1 + 2 * row_2 - row_3;
+
+			db_0[i] = row_2;
+			db_1[i] = row_3;
 		}
+		buffer += sb_size << 2;
 	}
 }
@@ -30,11 +30,14 @@ class CSubbandDecoder {
 private:
 	int levels, block_size;
 	int* memory_buffer;
+	int* state_buffer; // per column state of the row recurrence, see reconstruct_rows
 	void sub_4d3fcc(short* memory, int* buffer, int sb_size, int blocks);
 	void sub_4d420c(int* memory, int* buffer, int sb_size, int blocks);
+	void reconstruct_rows(int* buffer, int sb_size, int groups, int* db_0, int* db_1);
 public:
 	CSubbandDecoder(int lev_cnt)
-		: levels( lev_cnt ), block_size( 1 << lev_cnt ), memory_buffer( NULL )
+		: levels( lev_cnt ), block_size( 1 << lev_cnt ), memory_buffer( NULL ),
+		state_buffer( NULL )
 	{
 	}
 	virtual ~CSubbandDecoder()
@@ -42,6 +45,9 @@ public:
 		if (memory_buffer) {
 			free( memory_buffer );
 		}
+		if (state_buffer) {
+			free( state_buffer );
+		}
 	}
 
 	int init_decoder();
@@ -84,6 +84,19 @@ FillerProc Fillers[32] = {
 
 inline void CValueUnpacker::prepare_bits(int bits)
 {
+	if (bits <= avail_bits) {
+		return;
+	}
+	// while the buffer has enough bytes left, top up next_bits as far as it
+	// goes in one go, so the following requests don't need to come here
+	// (all users mask what they get, so the extra bits don't matter)
+	if (buffer_bit_offset + 4 <= UNPACKER_BUFFER_SIZE) {
+		while (avail_bits <= 24) {
+			next_bits |= ( ( unsigned int ) bits_buffer[buffer_bit_offset++] << avail_bits );
+			avail_bits += 8;
+		}
+		return;
+	}
 	while (bits > avail_bits) {
 		unsigned char one_byte;
 		if (buffer_bit_offset == UNPACKER_BUFFER_SIZE) {
@@ -42,6 +42,7 @@
 #include "Scriptable/Door.h"
 #include "Scriptable/InfoPoint.h"
 #include "System/FileStream.h"
+#include "System/MemoryStream.h"
 #include "System/SlicedStream.h"
 
 #include <stdlib.h>
@@ -170,7 +171,8 @@ bool AREImporter::Open(DataStream* stream)
 		return false;
 	}
 	delete str;
-	str = stream;
+	// records are read field by field, so do it from memory
+	str = LoadIntoMemory(stream);
 	char Signature[8];
 	str->Read( Signature, 8 );
 
@@ -1341,7 +1343,7 @@ Map* AREImporter::GetMap(const char *ResRef, bool day_or_night)
 
 		//This could be wrong on msvc7 with its separate memory managers
 		EffectQueue *fxqueue = new EffectQueue();
-		DataStream *fs = new SlicedStream( str, TrapEffOffset, TrapSize);
+		DataStream *fs = SliceStream( str, TrapEffOffset, TrapSize, true);
 
 		ReadEffects((DataStream *) fs,fxqueue, TrapEffectCount);
 		Actor * caster = core->GetGame()->FindPC(PartyID);
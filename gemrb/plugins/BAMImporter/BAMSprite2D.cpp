@@ -84,6 +84,14 @@ void BAMSprite2D::SetPalette(Palette* palette)
 	pal = palette;
 }
 
+const RLERowOffset* BAMSprite2D::GetRLERowIndex() const
+{
+	if (!RLE) {
+		return NULL;
+	}
+	return source->GetRLERowIndex(pixels, Width, Height, colorkey);
+}
+
 Color BAMSprite2D::GetPixel(unsigned short x, unsigned short y) const
 {
 	Color c = { 0, 0, 0, 0 };
@@ -98,6 +106,12 @@ Color BAMSprite2D::GetPixel(unsigned short x, unsigned short y) const
 
 	const ieByte *rle = (const ieByte*)pixels;
 	if (RLE) {
+		const RLERowOffset* rows = GetRLERowIndex();
+		if (rows) {
+			// start at the row instead of decoding all the ones above it
+			rle += rows[y].offset;
+			skipcount = rows[y].lead + x;
+		}
 		while (skipcount > 0) {
 			if (*rle++ == colorkey)
 				skipcount -= (*rle++)+1;
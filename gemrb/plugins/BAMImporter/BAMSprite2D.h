@@ -50,6 +50,7 @@ public:
 	Color GetPixel(unsigned short x, unsigned short y) const;
 	ieDword GetColorKey() const { return colorkey; };
 	void SetColorKey(ieDword ck) { colorkey = (ieByte)ck; };
+	const RLERowOffset* GetRLERowIndex() const;
 };
 
 }
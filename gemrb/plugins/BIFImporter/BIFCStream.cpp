@@ -0,0 +1,197 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "BIFCStream.h"
+
+#include "win32def.h"
+
+#include "Interface.h"
+#include "System/MemoryStream.h"
+
+#include <algorithm>
+
+using namespace GemRB;
+
+BIFCBlocks::BIFCBlocks(DataStream* file)
+	: file(file), comp(PLUGIN_COMPRESSION_ZLIB), totalSize(0)
+{
+}
+
+BIFCBlocks::~BIFCBlocks()
+{
+	std::list<CachedBlock>::iterator it;
+	for (it = cache.begin(); it != cache.end(); ++it) {
+		delete it->data;
+	}
+	delete file;
+}
+
+bool BIFCBlocks::ReadIndex()
+{
+	ieDword unCompBifSize;
+	if (file->ReadDword(&unCompBifSize) != 4) {
+		return false;
+	}
+
+	// only the block headers are read here, the data is inflated on demand
+	while (totalSize < unCompBifSize) {
+		Block block;
+		if (file->ReadDword(&block.declen) != 4 || file->ReadDword(&block.complen) != 4) {
+			return false;
+		}
+		if (!block.declen || block.complen > file->Remains()) {
+			return false;
+		}
+		block.offset = totalSize;
+		block.compOffset = file->GetPos();
+		blocks.push_back(block);
+		totalSize += block.declen;
+		file->Seek(block.complen, GEM_CURRENT_POS);
+	}
+	return true;
+}
+
+DataStream* BIFCBlocks::GetBlock(size_t index)
+{
+	std::list<CachedBlock>::iterator it;
+	for (it = cache.begin(); it != cache.end(); ++it) {
+		if (it->index == index) {
+			cache.splice(cache.begin(), cache, it);
+			return it->data;
+		}
+	}
+
+	const Block& block = blocks[index];
+	void* data = malloc(block.declen);
+	DataStream* out = new MemoryStream(file->originalfile, data, block.declen);
+	file->Seek(block.compOffset, GEM_STREAM_START);
+	if (comp->Decompress(out, file, block.complen) != GEM_OK || out->GetPos() != block.declen) {
+		Log(ERROR, "BIFCStream", "Cannot decompress block %d of %s.", (int) index, file->originalfile);
+		delete out;
+		return NULL;
+	}
+
+	if (cache.size() >= BIFC_CACHED_BLOCKS) {
+		delete cache.back().data;
+		cache.pop_back();
+	}
+	CachedBlock entry = { index, out };
+	cache.push_front(entry);
+	return out;
+}
+
+bool BIFCBlocks::Read(void* dest, unsigned long pos, unsigned int len)
+{
+	if (pos + len > totalSize) {
+		return false;
+	}
+
+	// find the block holding pos (the last one starting at or before it)
+	size_t index = 0;
+	size_t lo = 0, hi = blocks.size();
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		if (blocks[mid].offset <= pos) {
+			index = mid;
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	char* out = (char*) dest;
+	while (len) {
+		DataStream* data = GetBlock(index);
+		if (!data) {
+			return false;
+		}
+		ieDword inBlock = (ieDword) (pos - blocks[index].offset);
+		unsigned int chunk = std::min(len, (unsigned int) (blocks[index].declen - inBlock));
+		data->Seek(inBlock, GEM_STREAM_START);
+		if (data->Read(out, chunk) != (int) chunk) {
+			return false;
+		}
+		out += chunk;
+		pos += chunk;
+		len -= chunk;
+		index++;
+	}
+	return true;
+}
+
+BIFCStream::BIFCStream(BIFCBlocks* blocks, const char* path)
+	: blocks(blocks)
+{
+	size = blocks->GetSize();
+	ExtractFileFromPath(filename, path);
+	strlcpy(originalfile, path, _MAX_PATH);
+}
+
+DataStream* BIFCStream::Clone()
+{
+	return new BIFCStream(blocks.get(), originalfile);
+}
+
+int BIFCStream::Read(void* dest, unsigned int length)
+{
+	//we don't allow partial reads anyway
+	if (Pos+length>size ) {
+		return GEM_ERROR;
+	}
+	if (!blocks->Read(dest, Pos, length)) {
+		return GEM_ERROR;
+	}
+	if (Encrypted) {
+		ReadDecrypted( dest, length );
+	}
+	Pos += length;
+	return length;
+}
+
+int BIFCStream::Write(const void* /*src*/, unsigned int /*length*/)
+{
+	error("BIFCStream", "Attempted to write to a compressed archive!");
+}
+
+int BIFCStream::Seek(int newpos, int type)
+{
+	switch (type) {
+		case GEM_CURRENT_POS:
+			Pos += newpos;
+			break;
+
+		case GEM_STREAM_START:
+			Pos = newpos;
+			break;
+
+		case GEM_STREAM_END:
+			Pos = size - newpos;
+			break;
+
+		default:
+			return GEM_ERROR;
+	}
+	//we went past the buffer
+	if (Pos>size) {
+		print("[Streams]: Invalid seek position: %ld(limit: %ld)", Pos, size);
+		return GEM_ERROR;
+	}
+	return GEM_OK;
+}
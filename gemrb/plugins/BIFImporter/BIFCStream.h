@@ -0,0 +1,93 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2003 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef BIFCSTREAM_H
+#define BIFCSTREAM_H
+
+#include "globals.h"
+
+#include "Compressor.h"
+#include "Holder.h"
+#include "PluginMgr.h"
+#include "System/DataStream.h"
+
+#include <list>
+#include <vector>
+
+namespace GemRB {
+
+// how many decompressed blocks are kept around per archive
+#define BIFC_CACHED_BLOCKS 32
+
+/**
+ * The block table of a BIFC V1.0 archive and a small cache of its
+ * decompressed blocks. Shared by a BIFCStream and all of its clones.
+ */
+class BIFCBlocks : public Held<BIFCBlocks> {
+private:
+	struct Block {
+		ieDword offset; // in the uncompressed data
+		ieDword declen;
+		unsigned long compOffset; // in the archive file
+		ieDword complen;
+	};
+	struct CachedBlock {
+		size_t index;
+		DataStream* data;
+	};
+
+	DataStream* file;
+	PluginHolder<Compressor> comp;
+	std::vector<Block> blocks;
+	// most recently used first
+	std::list<CachedBlock> cache;
+	ieDword totalSize;
+
+	DataStream* GetBlock(size_t index);
+public:
+	/** takes ownership of file, which has to be positioned right after the signature */
+	BIFCBlocks(DataStream* file);
+	~BIFCBlocks();
+	/** reads the block headers, returns false on a corrupt archive */
+	bool ReadIndex();
+	ieDword GetSize() const { return totalSize; }
+	/** copies uncompressed data, decompressing only the blocks it overlaps */
+	bool Read(void* dest, unsigned long pos, unsigned int len);
+};
+
+/**
+ * @class BIFCStream
+ * Random access stream over the uncompressed contents of a BIFC archive.
+ */
+class BIFCStream : public DataStream {
+private:
+	Holder<BIFCBlocks> blocks;
+public:
+	BIFCStream(BIFCBlocks* blocks, const char* path);
+	DataStream* Clone();
+
+	int Read(void* dest, unsigned int length);
+	int Write(const void* src, unsigned int length);
+	int Seek(int pos, int startpos);
+};
+
+}
+
+#endif
@@ -19,6 +19,7 @@
  */
 
 #include "BIFImporter.h"
+#include "BIFCStream.h"
 
 #include "win32def.h"
 
@@ -54,50 +55,21 @@ BIFImporter::~BIFImporter(void)
 
 DataStream* BIFImporter::DecompressBIFC(DataStream* compressed, const char* path)
 {
-	print("Decompressing");
-	if (!core->IsAvailable( PLUGIN_COMPRESSION_ZLIB ))
-		return NULL;
-	PluginHolder<Compressor> comp(PLUGIN_COMPRESSION_ZLIB);
-	ieDword unCompBifSize;
-	compressed->ReadDword( &unCompBifSize );
-	//print( "\nDecompressing file: [..........]" );
-	fflush(stdout);
-	FileStream out;
-	if (!out.Create(path)) {
-		Log(ERROR, "BIFImporter", "Cannot write %s.", path);
+	if (!core->IsAvailable( PLUGIN_COMPRESSION_ZLIB )) {
+		delete compressed;
 		return NULL;
 	}
-	ieDword finalsize = 0;
-	int laststep = 0;
-	while (finalsize < unCompBifSize) {
-		ieDword complen, declen;
-		compressed->ReadDword( &declen );
-		compressed->ReadDword( &complen );
-		if (comp->Decompress( &out, compressed, complen ) != GEM_OK) {
-			return NULL;
-		}
-		finalsize = out.GetPos();
-		if (( int ) ( finalsize * ( 10.0 / unCompBifSize ) ) != laststep) {
-			laststep++;
-			/*
-			print( "\b\b\b\b\b\b\b\b\b\b\b" );
-			int l;
-
-			for (l = 0; l < laststep; l++)
-				print( "|" );
-			for (; l < 10; l++)//l starts from laststep
-				print( "." );
-			print( "]" );
-			fflush(stdout);
-			*/
-		}
+	// blocks are inflated on demand, only when a resource overlapping them is read
+	BIFCBlocks* blocks = new BIFCBlocks(compressed);
+	if (!blocks->ReadIndex()) {
+		Log(ERROR, "BIFImporter", "Corrupt compressed archive %s.", path);
+		delete blocks;
+		return NULL;
 	}
-	//print("\n");
-	out.Close(); // This is necesary, since windows won't open the file otherwise.
-	return FileStream::OpenFile(path);
+	return new BIFCStream(blocks, path);
 }
 
-DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const char* /*path*/)
+DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const char* path)
 {
 	ieDword fnlen, complen, declen;
 	compressed->ReadDword( &fnlen );
@@ -105,7 +77,7 @@ DataStream* BIFImporter::DecompressBIF(DataStream* compressed, const char* /*pat
 	compressed->ReadDword(&declen);
 	compressed->ReadDword(&complen);
 	print("Decompressing");
-	return CacheCompressedStream(compressed, compressed->filename, complen);
+	return CacheArchive(compressed, path, complen);
 }
 
 int BIFImporter::OpenArchive(const char* path)
@@ -115,12 +87,7 @@ int BIFImporter::OpenArchive(const char* path)
 		stream = NULL;
 	}
 
-	char filename[_MAX_PATH];
-	ExtractFileFromPath(filename, path);
-
-	char cachePath[_MAX_PATH];
-	PathJoin(cachePath, core->CachePath, filename, NULL);
-	stream = FileStream::OpenFile(cachePath);
+	stream = OpenCachedArchive(path);
 
 	char Signature[8];
 	if (!stream) {
@@ -134,11 +101,11 @@ int BIFImporter::OpenArchive(const char* path)
 		}
 
 		if (strncmp(Signature, "BIF V1.0", 8) == 0) {
-			stream = DecompressBIF(file, cachePath);
+			stream = DecompressBIF(file, path);
 			delete file;
 		} else if (strncmp(Signature, "BIFCV1.0", 8) == 0) {
-			stream = DecompressBIFC(file, cachePath);
-			delete file;
+			// takes ownership of file
+			stream = DecompressBIFC(file, path);
 		} else if (strncmp( Signature, "BIFFV1  ", 8 ) == 0) {
 			file->Seek(0, GEM_STREAM_START);
 			stream = file;
@@ -577,11 +577,14 @@ static inline void ff_fill_linesize(AVFrame *picture, int width)
 	picture->linesize[2] = w2;
 }
 
+//planes left over from an earlier frame are reused, every block gets redrawn
 static inline void get_buffer(AVFrame *p, int width, int height)
 {
 	ff_fill_linesize(p, width);
 	for(int plane=0;plane<3;plane++) {
-		p->data[plane] = (uint8_t *) av_malloc(p->linesize[plane]*height);
+		if (!p->data[plane]) {
+			p->data[plane] = (uint8_t *) av_malloc(p->linesize[plane]*height);
+		}
 	}
 }
 
@@ -1235,25 +1238,6 @@ inline int BIKPlayer::get_value(int bundle)
 	dst[(x)*2 +     ((y)*2 + 1) * stride] = \
 	dst[(x)*2 + 1 + ((y)*2 + 1) * stride] = pix;
 
-static void get_pixels(DCTELEM *block, const uint8_t *pixels, int line_size)
-{
-	int i;
-
-	/* read the pixels */
-	for(i=0;i<8;i++) {
-		block[0] = pixels[0];
-		block[1] = pixels[1];
-		block[2] = pixels[2];
-		block[3] = pixels[3];
-		block[4] = pixels[4];
-		block[5] = pixels[5];
-		block[6] = pixels[6];
-		block[7] = pixels[7];
-		pixels += line_size;
-		block += 8;
-	}
-}
-
 static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
 {
 	int i;
@@ -1291,10 +1275,14 @@ static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int lin
 	}
 }
 
-static inline void copy_block(DCTELEM block[64], const uint8_t *src, uint8_t *dst, int stride)
+//the previous frame is a separate buffer, so plain row copies are enough
+static inline void copy_block(const uint8_t *src, uint8_t *dst, int stride)
 {
-	get_pixels(block, src, stride);
-	put_pixels_nonclamped(block, dst, stride);
+	for (int i = 0; i < 8; i++) {
+		memcpy(dst, src, 8);
+		src += stride;
+		dst += stride;
+	}
 }
 
 #define clear_block(block) memset( (block), 0, sizeof(DCTELEM)*64);
@@ -1458,7 +1446,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 				}
 				switch (blk) {
 				case SKIP_BLOCK:
-					copy_block(block, prev, dst, stride);
+					copy_block(prev, dst, stride);
 					break;
 				case SCALED_BLOCK:
 					blk = get_value(BINK_SRC_SUB_BLOCK_TYPES);
@@ -1532,7 +1520,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 				case MOTION_BLOCK:
 					xoff = get_value(BINK_SRC_X_OFF);
 					yoff = get_value(BINK_SRC_Y_OFF);
-					copy_block(block, prev + xoff + yoff*stride, dst, stride);
+					copy_block(prev + xoff + yoff*stride, dst, stride);
 					break;
 				case RUN_BLOCK:
 					scan = bink_patterns[v_gb.get_bits(4)];
@@ -1561,7 +1549,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 				case RESIDUE_BLOCK:
 					xoff = get_value(BINK_SRC_X_OFF);
 					yoff = get_value(BINK_SRC_Y_OFF);
-					copy_block(block, prev + xoff + yoff*stride, dst, stride);
+					copy_block(prev + xoff + yoff*stride, dst, stride);
 					clear_block(block);
 					v = v_gb.get_bits(7);
 					read_residue(block, v);
@@ -1582,7 +1570,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 				case INTER_BLOCK:
 					xoff = get_value(BINK_SRC_X_OFF);
 					yoff = get_value(BINK_SRC_Y_OFF);
-					copy_block(block, prev + xoff + yoff*stride, dst, stride);
+					copy_block(prev + xoff + yoff*stride, dst, stride);
 					clear_block(block);
 					block[0] = get_value(BINK_SRC_INTER_DC);
 					read_dct_coeffs(block, c_scantable.permutated,false);
@@ -1622,10 +1610,10 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 		showFrame((ieByte **) c_pic.data, (unsigned int *) c_pic.linesize, header.width, header.height, header.width, header.height, dest_x, dest_y);
 	}
 
-	//release the old frame even when frame is skipped
-	release_buffer(&c_last);
-	memcpy(&c_last, &c_pic, sizeof(AVFrame));
-	memset(&c_pic, 0, sizeof(AVFrame));
+	//swap the frames even when frame is skipped, the old one gets overwritten next
+	AVFrame tmp = c_last;
+	c_last = c_pic;
+	c_pic = tmp;
 	return 0;
 }
 
@@ -30,6 +30,7 @@
 #include "PluginMgr.h"
 #include "TableMgr.h"
 #include "GameScript/GameScript.h"
+#include "System/MemoryStream.h"
 
 #include <cassert>
 
@@ -556,7 +557,8 @@ bool CREImporter::Open(DataStream* stream)
 		return false;
 	}
 	delete str;
-	str = stream;
+	// records are read field by field, so do it from memory
+	str = LoadIntoMemory(stream);
 	char Signature[8];
 	str->Read( Signature, 8 );
 	IsCharacter = false;
@@ -1047,6 +1049,8 @@ Actor* CREImporter::GetActor(unsigned char is_in_party)
 	}
 	// Reading inventory, spellbook, etc
 	ReadInventory( act, Inventory_Size );
+	// the spell pages were filled directly, so drop anything cached meanwhile
+	act->spellbook.InvalidateSpells();
 
 	if (IsCharacter) {
 		ReadChrHeader(act);
@@ -25,6 +25,11 @@
 #include "ResourceDesc.h"
 #include "System/FileStream.h"
 
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
 using namespace GemRB;
 
 DirectoryImporter::DirectoryImporter(void)
@@ -116,37 +121,124 @@ bool CachedDirectoryImporter::Open(const char *dir, const char *desc)
 	return true;
 }
 
-void CachedDirectoryImporter::Refresh()
+// directory listings are remembered in the cache directory, so unchanged
+// directories don't need to be scanned (stat'ing every entry) on each startup
+struct DirectoryListing {
+	unsigned long mtime; // of the directory
+	unsigned long scanned; // when the listing was taken
+	std::vector<std::string> files;
+};
+
+typedef std::map<std::string, DirectoryListing> ListingIndex;
+
+#define LISTING_INDEX "dirlist.idx"
+
+static ListingIndex listings;
+static bool listingsLoaded = false;
+
+static void LoadListings()
 {
-	cache.clear();
+	if (listingsLoaded)
+		return;
+	listingsLoaded = true;
+
+	char path[_MAX_PATH];
+	PathJoin(path, core->CachePath, LISTING_INDEX, NULL);
+	FILE *fp = fopen(path, "r");
+	if (!fp)
+		return;
 
-	DirectoryIterator it(path);
-	if (!it)
+	// a header line with the stamps, file count and path, then the file names
+	char line[_MAX_PATH];
+	DirectoryListing listing;
+	unsigned int count;
+	while (fgets(line, sizeof(line), fp)) {
+		char dir[_MAX_PATH];
+		if (sscanf(line, "%lu %lu %u %259[^\n]", &listing.mtime, &listing.scanned, &count, dir) != 4)
+			break;
+		listing.files.clear();
+		listing.files.reserve(count);
+		while (count-- && fgets(line, sizeof(line), fp)) {
+			line[strcspn(line, "\r\n")] = 0;
+			listing.files.push_back(line);
+		}
+		listings[dir] = listing;
+	}
+	fclose(fp);
+}
+
+static void SaveListings()
+{
+	char path[_MAX_PATH];
+	PathJoin(path, core->CachePath, LISTING_INDEX, NULL);
+	FILE *fp = fopen(path, "w");
+	if (!fp) {
+		Log(WARNING, "CachedDirectoryImporter", "Cannot write %s.", path);
 		return;
+	}
+	ListingIndex::const_iterator it;
+	for (it = listings.begin(); it != listings.end(); ++it) {
+		const DirectoryListing &listing = it->second;
+		fprintf(fp, "%lu %lu %u %s\n", listing.mtime, listing.scanned,
+			(unsigned int) listing.files.size(), it->first.c_str());
+		for (size_t i = 0; i < listing.files.size(); i++) {
+			fprintf(fp, "%s\n", listing.files[i].c_str());
+		}
+	}
+	fclose(fp);
+}
 
-	unsigned int count = 0;
+static const std::vector<std::string> *GetListing(const char *dir)
+{
+	struct stat buf;
+	if (stat(dir, &buf) < 0)
+		return NULL;
+
+	LoadListings();
+	DirectoryListing &listing = listings[dir];
+	// anything changed in the same second as the last scan could be missing
+	if (listing.mtime == (unsigned long) buf.st_mtime && listing.mtime < listing.scanned)
+		return &listing.files;
+
+	DirectoryIterator it(dir);
+	if (!it) {
+		listings.erase(dir);
+		return NULL;
+	}
+	listing.mtime = (unsigned long) buf.st_mtime;
+	listing.scanned = (unsigned long) time(NULL);
+	listing.files.clear();
 	do {
 		if (it.IsDirectory())
 			continue;
-		count++;
+		listing.files.push_back(it.GetName());
 	} while (++it);
 
+	SaveListings();
+	return &listing.files;
+}
+
+void CachedDirectoryImporter::Refresh()
+{
+	cache.clear();
+
+	const std::vector<std::string> *files = GetListing(path);
+	if (!files)
+		return;
+
+	unsigned int count = (unsigned int) files->size();
 	// limit to 4k buckets
 	// less than 1% of the bg2+fixpack override are of bucket length >4
 	cache.init(count > 4 * 1024 ? 4 * 1024 : count, count);
 
-	it.Rewind();
-
 	char buf[_MAX_PATH];
-	do {
-		if (it.IsDirectory())
-			continue;
-		const char *name = it.GetName();
+	for (unsigned int i = 0; i < count; i++) {
+		const char *name = (*files)[i].c_str();
 		strnlwrcpy(buf, name, _MAX_PATH, false);
 		if (cache.set(buf, name)) {
 			Log(ERROR, "CachedDirectoryImporter", "Duplicate '%s' files in '%s' directory", buf, path);
 		}
-	} while (++it);
+	}
 }
 
 static const char *ConstructFilename(const char* resname, const char* ext)
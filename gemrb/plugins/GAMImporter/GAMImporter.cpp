@@ -30,6 +30,7 @@
 #include "PluginMgr.h"
 #include "TableMgr.h"
 #include "Scriptable/Actor.h"
+#include "System/MemoryStream.h"
 #include "System/SlicedStream.h"
 
 #include <cassert>
@@ -63,7 +64,8 @@ bool GAMImporter::Open(DataStream* stream)
 	if (str) {
 		return false;
 	}
-	str = stream;
+	// records are read field by field, so do it from memory
+	str = LoadIntoMemory(stream);
 	char Signature[8];
 	str->Read( Signature, 8 );
 	if (strncmp( Signature, "GAMEV0.0", 8 ) == 0) {
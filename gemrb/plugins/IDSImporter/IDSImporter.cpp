@@ -25,6 +25,7 @@
 #include "globals.h"
 #include "win32def.h"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace GemRB;
@@ -81,25 +82,54 @@ bool IDSImporter::Open(DataStream* str)
 	}
 
 	delete str;
+	BuildIndex();
 	return true;
 }
 
-int IDSImporter::GetValue(const char* txt) const
+struct PairNameLess {
+	const std::vector<Pair>& pairs;
+	PairNameLess(const std::vector<Pair>& p) : pairs(p) {}
+	bool operator()(unsigned int a, unsigned int b) const
+	{
+		return strcmp(pairs[a].str, pairs[b].str) < 0;
+	}
+};
+
+void IDSImporter::BuildIndex()
 {
-	for (unsigned int i = 0; i < pairs.size(); i++) {
-		if (stricmp( pairs[i].str, txt ) == 0) {
-			return pairs[i].val;
+	unsigned int size = pairs.size();
+	nameIndex.init(size * 2 + 1, size + 1);
+	valueIndex.init(size * 2 + 1, size + 1);
+	lastValueIndex.init(size * 2 + 1, size + 1);
+	sortedIndex.resize(size);
+	for (unsigned int i = 0; i < size; i++) {
+		std::string name(pairs[i].str);
+		if (!nameIndex.has(name)) {
+			nameIndex.set(name, i);
 		}
+		if (!valueIndex.has(pairs[i].val)) {
+			valueIndex.set(pairs[i].val, i);
+		}
+		lastValueIndex.set(pairs[i].val, i);
+		sortedIndex[i] = i;
+	}
+	std::sort(sortedIndex.begin(), sortedIndex.end(), PairNameLess(pairs));
+}
+
+int IDSImporter::GetValue(const char* txt) const
+{
+	const unsigned int *i = nameIndex.get(std::string(txt));
+	if (i) {
+		return pairs[*i].val;
 	}
 	return -1;
 }
 
 char* IDSImporter::GetValue(int val) const
 {
-	for (unsigned int i = 0; i < pairs.size(); i++) {
-		if (pairs[i].val == val) {
-			return pairs[i].str;
-		}
+	const unsigned int *i = valueIndex.get(val);
+	if (i) {
+		return pairs[*i].str;
 	}
 	return NULL;
 }
@@ -120,24 +150,43 @@ int IDSImporter::GetValueIndex(unsigned int Index) const
 	return pairs[Index].val;
 }
 
+// the names are stored lowercased, so a lowercased prefix can be
+// searched for in the name ordered index
 int IDSImporter::FindString(char *str, int len) const
 {
-	int i=pairs.size();
-	while(i--) {
-		if (strnicmp(pairs[i].str, str, len) == 0) {
-			return i;
+	std::string prefix(str, strnlen(str, len));
+	for (size_t c = 0; c < prefix.length(); c++) {
+		prefix[c] = tolower(prefix[c]);
+	}
+
+	int found = -1;
+	unsigned int lo = 0, hi = sortedIndex.size();
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+		if (strncmp(pairs[sortedIndex[mid]].str, prefix.c_str(), len) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
 		}
 	}
-	return -1;
+	// like the old backwards scan, prefer the last matching entry
+	for (; lo < sortedIndex.size(); lo++) {
+		int i = sortedIndex[lo];
+		if (strncmp(pairs[i].str, prefix.c_str(), len) != 0) {
+			break;
+		}
+		if (i > found) {
+			found = i;
+		}
+	}
+	return found;
 }
 
 int IDSImporter::FindValue(int val) const
 {
-	int i=pairs.size();
-	while(i--) {
-		if(pairs[i].val==val) {
-			return i;
-		}
+	const unsigned int *i = lastValueIndex.get(val);
+	if (i) {
+		return *i;
 	}
 	return -1;
 }
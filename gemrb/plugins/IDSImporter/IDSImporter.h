@@ -23,6 +23,8 @@
 
 #include "SymbolMgr.h"
 
+#include "StringMap.h"
+
 #include <vector>
 
 namespace GemRB {
@@ -36,6 +38,13 @@ class IDSImporter : public SymbolMgr {
 private:
 	std::vector< Pair> pairs;
 	std::vector< char*> ptrs;
+	// lookup indices built once the file is read
+	HashMap<std::string, unsigned int> nameIndex; // first entry with a name
+	HashMap<int, unsigned int> valueIndex; // first entry with a value
+	HashMap<int, unsigned int> lastValueIndex; // last entry with a value
+	std::vector< unsigned int> sortedIndex; // entries in name order, for prefix searches
+
+	void BuildIndex();
 
 public:
 	IDSImporter(void);
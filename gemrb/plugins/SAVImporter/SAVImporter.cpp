@@ -58,7 +58,7 @@ int SAVImporter::DecompressSaveGame(DataStream *compressed)
 		strlwr(fname);
 		compressed->ReadDword( &declen );
 		compressed->ReadDword( &complen );
-		print("Decompressing %s", fname);
+		Log(DEBUG, "SAVImporter", "Decompressing %s", fname);
 		DataStream* cached = CacheCompressedStream(compressed, fname, complen, true);
 		free( fname );
 		if (!cached)
@@ -28,6 +28,7 @@
 #include "MusicMgr.h"
 #include "SoundMgr.h"
 
+#include <cmath>
 #include <SDL.h>
 #include <SDL_mixer.h>
 
@@ -41,6 +42,7 @@ SDLAudio::SDLAudio(void)
 	MusicPlaying = false;
 	OurMutex = NULL;
 	curr_buffer_offset = 0;
+	cacheSize = 0;
 	audio_rate = audio_format = audio_channels = 0;
 }
 
@@ -50,8 +52,10 @@ SDLAudio::~SDLAudio(void)
 	delete ambim;
 	Mix_HookMusic(NULL, NULL);
 	FreeBuffers();
-	SDL_DestroyMutex(OurMutex);
 	Mix_ChannelFinished(NULL);
+	Mix_HaltChannel(-1);
+	clearBufferCache();
+	SDL_DestroyMutex(OurMutex);
 }
 
 // no user data for Mix_ChannelFinished :(
@@ -122,32 +126,28 @@ void SDLAudio::channel_done_callback(int channel) {
 	assert(g_sdlaudio);
 	assert((unsigned int)channel < g_sdlaudio->channel_data.size());
 	assert(g_sdlaudio->channel_data[channel]);
-	free(g_sdlaudio->channel_data[channel]);
+	// the chunk stays in the cache for the next time it is played
+	g_sdlaudio->channel_data[channel]->Users--;
 	g_sdlaudio->channel_data[channel] = NULL;
 	SDL_mutexV(g_sdlaudio->OurMutex);
 }
 
-Holder<SoundHandle> SDLAudio::Play(const char* ResRef, int XPos, int YPos, unsigned int flags, unsigned int *length)
+// returns the sound converted to the device format, decoding it only if it isn't cached
+SDLCacheEntry* SDLAudio::loadSound(const char *ResRef, unsigned int &time_length)
 {
-	// TODO: some panning
-	(void)XPos;
-	(void)YPos;
-
-	// TODO: flags
-	(void)flags;
-
-	if (!ResRef) {
-		if (flags & GEM_SND_SPEECH) {
-			Mix_HaltChannel(0);
-		}
-		return Holder<SoundHandle>();
+	void* p;
+	if (buffercache.Lookup(ResRef, p)) {
+		SDLCacheEntry* e = (SDLCacheEntry*) p;
+		buffercache.Touch(ResRef);
+		time_length = e->Length;
+		return e;
 	}
 
 	// TODO: move this loading code somewhere central
 	ResourceHolder<SoundMgr> acm(ResRef);
 	if (!acm) {
 		print("failed acm load");
-		return Holder<SoundHandle>();
+		return NULL;
 	}
 	int cnt = acm->get_length();
 	int riff_chans = acm->get_channels();
@@ -157,11 +157,7 @@ Holder<SoundHandle> SDLAudio::Play(const char* ResRef, int XPos, int YPos, unsig
 	//multiply always with 2 because it is in 16 bits
 	int cnt1 = acm->read_samples( memory, cnt ) * 2;
 	//Sound Length in milliseconds
-	unsigned int time_length = ((cnt / riff_chans) * 1000) / samplerate;
-
-	if (length) {
-		*length = time_length;
-	}
+	time_length = ((cnt / riff_chans) * 1000) / samplerate;
 
 	// convert our buffer, if necessary
 	SDL_AudioCVT cvt;
@@ -179,25 +175,130 @@ Holder<SoundHandle> SDLAudio::Play(const char* ResRef, int XPos, int YPos, unsig
 	Mix_Chunk *chunk = Mix_QuickLoad_RAW(cvt.buf, cvt.len*cvt.len_ratio);
 	if (!chunk) {
 		print("error loading chunk");
+		free(cvt.buf);
+		return NULL;
+	}
+
+	SDLCacheEntry* e = new SDLCacheEntry;
+	e->chunk = chunk;
+	e->Length = time_length;
+	e->Size = chunk->alen;
+	e->Users = 0;
+
+	// make room first, so the new sound can't be the one evicted
+	SDL_mutexP(OurMutex);
+	evictBuffers(e->Size);
+	SDL_mutexV(OurMutex);
+	buffercache.SetAt(ResRef, (void*)e);
+	cacheSize += e->Size;
+	return e;
+}
+
+static void FreeCacheEntry(SDLCacheEntry* e)
+{
+	// QuickLoad_RAW chunks don't own their data
+	Uint8* buf = e->chunk->abuf;
+	Mix_FreeChunk(e->chunk);
+	free(buf);
+	delete e;
+}
+
+void SDLAudio::evictBuffers(unsigned int incoming)
+{
+	// Note: this function assumes the caller holds OurMutex
+
+	unsigned int n = 0;
+	void* p;
+	const char* k;
+	while (cacheSize + incoming > BUFFER_CACHE_LIMIT && buffercache.getLRU(n, k, p)) {
+		SDLCacheEntry* e = (SDLCacheEntry*)p;
+		if (e->Users) {
+			// still playing somewhere, try the next least recently used
+			++n;
+			continue;
+		}
+		cacheSize -= e->Size;
+		FreeCacheEntry(e);
+		buffercache.Remove(k);
+	}
+}
+
+void SDLAudio::clearBufferCache()
+{
+	void* p;
+	const char* k;
+	while (buffercache.getLRU(0, k, p)) {
+		FreeCacheEntry((SDLCacheEntry*)p);
+		buffercache.Remove(k);
+	}
+	cacheSize = 0;
+}
+
+Holder<SoundHandle> SDLAudio::Play(const char* ResRef, int XPos, int YPos, unsigned int flags, unsigned int *length)
+{
+	// TODO: flags
+
+	if (!ResRef) {
+		if (flags & GEM_SND_SPEECH) {
+			Mix_HaltChannel(0);
+		}
+		return Holder<SoundHandle>();
+	}
+
+	unsigned int time_length;
+	SDLCacheEntry* e = loadSound(ResRef, time_length);
+	if (!e) {
 		return Holder<SoundHandle>();
 	}
 
+	if (length) {
+		*length = time_length;
+	}
+
+	// where the sound is, as seen from the listener
+	int dx = XPos;
+	int dy = YPos;
+	if (!(flags & GEM_SND_RELATIVE)) {
+		dx -= this->XPos;
+		dy -= this->YPos;
+	}
+	// a distance of 0 with an angle of 0 turns the positioning off
+	Sint16 angle = 0;
+	Uint8 distance = 0;
+	if (dx || dy) {
+		// 0 is straight ahead (up the screen), 90 to the right
+		double degrees = atan2((double) dx, (double) -dy) * 180.0 / 3.14159265358979;
+		if (degrees < 0) {
+			degrees += 360;
+		}
+		angle = (Sint16) degrees;
+		double dist = sqrt((double) dx * dx + (double) dy * dy);
+		distance = (dist >= AUDIBLE_DISTANCE) ? 255 : (Uint8) (dist * 255 / AUDIBLE_DISTANCE);
+	}
+
 	// play
 	int channel = -1;
 	if (flags & GEM_SND_SPEECH) {
 		channel = 0;
 	}
+	// keep the mixer away until the channel is positioned
+	SDL_LockAudio();
 	SDL_mutexP(OurMutex);
-	channel = Mix_PlayChannel(channel, chunk, 0);
+	channel = Mix_PlayChannel(channel, e->chunk, 0);
 	if (channel < 0) {
 		SDL_mutexV(OurMutex);
+		SDL_UnlockAudio();
 		print("error playing channel");
 		return Holder<SoundHandle>();
 	}
+	// SDL_mixer does the panning and the distance attenuation
+	Mix_SetPosition(channel, angle, distance);
 
 	assert((unsigned int)channel < channel_data.size());
-	channel_data[channel] = cvt.buf;
+	channel_data[channel] = e;
+	e->Users++;
 	SDL_mutexV(OurMutex);
+	SDL_UnlockAudio();
 
 	// TODO
 	return Holder<SoundHandle>();
@@ -242,14 +343,12 @@ bool SDLAudio::CanPlay()
 
 void SDLAudio::UpdateListenerPos(int x, int y)
 {
-	// TODO
 	XPos = x;
 	YPos = y;
 }
 
 void SDLAudio::GetListenerPos(int& x, int& y)
 {
-	// TODO
 	x = XPos;
 	y = YPos;
 }
@@ -22,11 +22,18 @@
 #define SDLAUDIO_H
 
 #include "Audio.h"
+#include "LRUCache.h"
 
 #include <vector>
 
+struct Mix_Chunk;
 struct SDL_mutex;
 
+// bytes of converted sound effects kept around for replaying
+#define BUFFER_CACHE_LIMIT (16 * 1024 * 1024)
+// sounds this far away (in pixels) are barely audible
+#define AUDIBLE_DISTANCE 1000
+
 namespace GemRB {
 
 struct BufferedData {
@@ -34,6 +41,13 @@ struct BufferedData {
 	unsigned int size;
 };
 
+struct SDLCacheEntry {
+	Mix_Chunk *chunk;
+	unsigned int Length; // in milliseconds
+	unsigned int Size; // of the converted data
+	int Users; // channels playing it right now
+};
+
 class SDLAudio : public Audio {
 public:
 	SDLAudio(void);
@@ -61,12 +75,17 @@ public:
 
 private:
 	void FreeBuffers();
+	SDLCacheEntry* loadSound(const char *ResRef, unsigned int &time_length);
+	void evictBuffers(unsigned int incoming);
+	void clearBufferCache();
 
 	static void music_callback(void *udata, unsigned short *stream, int len);
 	static void buffer_callback(void *udata, char *stream, int len);
 	static void channel_done_callback(int channel);
 
-	std::vector<void *> channel_data;
+	std::vector<SDLCacheEntry *> channel_data;
+	LRUCache buffercache;
+	unsigned int cacheSize;
 
 	int XPos, YPos;
 	Holder<SoundMgr> MusicReader;
@@ -21,8 +21,22 @@
 
 using namespace GemRB;
 
+GLVideoDriver::GLVideoDriver()
+{
+	backgroundBuffer = NULL;
+	streamBuffer = 0;
+}
+
 GLVideoDriver::~GLVideoDriver()
 {
+	std::map<const SpriteCover*, std::vector<CoverTexture> >::iterator it;
+	for (it = coverTextures.begin(); it != coverTextures.end(); ++it) {
+		for (size_t i = 0; i < it->second.size(); i++) {
+			glDeleteTextures(1, &it->second[i].texture);
+		}
+	}
+	coverTextures.clear();
+	if (streamBuffer) glDeleteBuffers(1, &streamBuffer);
 	if (program32) program32->Release();
 	if (programPal) programPal->Release();
 	if (programPalGrayed) programPalGrayed->Release();
@@ -127,6 +141,7 @@ int GLVideoDriver::CreateDisplay(int w, int h, int bpp, bool fs, const char* tit
 #endif
 	if (!createPrograms()) return GEM_ERROR;
 	paletteManager = new GLPaletteManager();
+	glGenBuffers(1, &streamBuffer);
 	glViewport(GLViewport.x, GLViewport.y, GLViewport.w, GLViewport.h);
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -135,6 +150,14 @@ int GLVideoDriver::CreateDisplay(int w, int h, int bpp, bool fs, const char* tit
 	return GEM_OK;
 }
 
+// respecifying the whole store orphans the previous contents, so the
+// driver doesn't have to wait for pending draws using them
+void GLVideoDriver::streamVertices(const void* data, unsigned int size)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, streamBuffer);
+	glBufferData(GL_ARRAY_BUFFER, size, data, GL_STREAM_DRAW);
+}
+
 void GLVideoDriver::useProgram(GLSLProgram* program)
 {
 	if (lastUsedProgram == program) return;
@@ -371,10 +394,7 @@ void GLVideoDriver::GLBlitSprite(GLTextureSprite2D* spr, const Region& src, cons
 	GLint a_position = program->GetAttribLocation("a_position");
 	GLint a_texCoord = program->GetAttribLocation("a_texCoord");
 
-	GLuint buffer;
-	glGenBuffers(1, &buffer);
-	glBindBuffer(GL_ARRAY_BUFFER, buffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
+	streamVertices(data, sizeof(data));
 
 	glVertexAttribPointer(a_position, VERTEX_SIZE, GL_FLOAT, GL_FALSE, sizeof(GLfloat)*(VERTEX_SIZE + TEX_SIZE), 0);
 	glVertexAttribPointer(a_texCoord, TEX_SIZE, GL_FLOAT, GL_FALSE, sizeof(GLfloat)*(VERTEX_SIZE + TEX_SIZE), BUFFER_OFFSET(sizeof(GLfloat)*VERTEX_SIZE));
@@ -386,8 +406,7 @@ void GLVideoDriver::GLBlitSprite(GLTextureSprite2D* spr, const Region& src, cons
 
 	glDisableVertexAttribArray(a_texCoord);
 	glDisableVertexAttribArray(a_position);
-	
-	glDeleteBuffers(1, &buffer);
+
 	spritesPerFrame++;
 }
 
@@ -419,10 +438,7 @@ void GLVideoDriver::drawPolygon(Point* points, unsigned int count, const Color&
 		data[i*VERTEX_SIZE + 1] = 1.0f - (GLfloat)points[i].y*2/height;
 	}
 
-	GLuint buffer;
-	glGenBuffers(1, &buffer);
-	glBindBuffer(GL_ARRAY_BUFFER, buffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*VERTEX_SIZE*count, data, GL_STATIC_DRAW);
+	streamVertices(data, sizeof(GLfloat)*VERTEX_SIZE*count);
 	delete[] data;
 
 	GLint a_position = programRect->GetAttribLocation("a_position");			
@@ -438,9 +454,11 @@ void GLVideoDriver::drawPolygon(Point* points, unsigned int count, const Color&
 		glDrawArrays(GL_TRIANGLE_FAN, 0, count);
 	else if (mode == FilledTriangulation)
 		glDrawArrays(GL_TRIANGLES, 0, count);
+	else if (mode == Points)
+		glDrawArrays(GL_POINTS, 0, count);
+	else if (mode == Lines)
+		glDrawArrays(GL_LINES, 0, count);
 	glDisableVertexAttribArray(a_position);
-
-	glDeleteBuffers(1, &buffer);
 }
 
 void GLVideoDriver::SetPixel(short x, short y, const Color& color, bool clipped) {
@@ -466,6 +484,91 @@ void GLVideoDriver::SetPixel(short x, short y, const Color& color, bool clipped)
 	clearRect(region, color);
 }
 
+void GLVideoDriver::DrawPoints(const Point* points, const Color* colors, unsigned int count, bool clipped)
+{
+	if (!count) return;
+	int xoff = 0, yoff = 0;
+	int minx = 0, miny = 0, maxx = disp->w, maxy = disp->h;
+	if (clipped) {
+		xoff = xCorr;
+		yoff = yCorr;
+		minx = xCorr;
+		miny = yCorr;
+		maxx = xCorr + Viewport.w;
+		maxy = yCorr + Viewport.h;
+	}
+
+	// one draw call per run of equally colored points
+	std::vector<Point> run;
+	run.reserve(count);
+	for (unsigned int i = 0; i < count; i++) {
+		if (!run.empty() && colors[i] != colors[i-1]) {
+			drawPolygon(&run[0], run.size(), colors[i-1], Points);
+			run.clear();
+		}
+		int x = points[i].x + xoff;
+		int y = points[i].y + yoff;
+		if (x < minx || y < miny || x >= maxx || y >= maxy) {
+			continue;
+		}
+		run.push_back(Point(x, y));
+	}
+	if (!run.empty()) {
+		drawPolygon(&run[0], run.size(), colors[count-1], Points);
+	}
+}
+
+void GLVideoDriver::DrawLines(const Point* points, const Color* colors, unsigned int count, bool clipped)
+{
+	if (!count) return;
+	int xoff = 0, yoff = 0;
+	if (clipped) {
+		xoff = xCorr - Viewport.x;
+		yoff = yCorr - Viewport.y;
+	}
+
+	std::vector<Point> run;
+	run.reserve(count * 2);
+	for (unsigned int i = 0; i < count; i++) {
+		if (!run.empty() && colors[i] != colors[i-1]) {
+			drawPolygon(&run[0], run.size(), colors[i-1], Lines);
+			run.clear();
+		}
+		run.push_back(Point(points[2*i].x + xoff, points[2*i].y + yoff));
+		run.push_back(Point(points[2*i+1].x + xoff, points[2*i+1].y + yoff));
+	}
+	if (!run.empty()) {
+		drawPolygon(&run[0], run.size(), colors[count-1], Lines);
+	}
+}
+
+void GLVideoDriver::DrawRects(const Region* rgns, unsigned int count, const Color& color)
+{
+	if (!count) return;
+	if (SDL_ALPHA_OPAQUE == color.a) {
+		for (unsigned int i = 0; i < count; i++) {
+			clearRect(rgns[i], color);
+		}
+		return;
+	}
+
+	// translucent rectangles go out as a single triangle list
+	std::vector<Point> triangles;
+	triangles.reserve(count * 6);
+	for (unsigned int i = 0; i < count; i++) {
+		const Region& rgn = rgns[i];
+		Point tl(rgn.x, rgn.y), tr(rgn.x + rgn.w, rgn.y);
+		Point br(rgn.x + rgn.w, rgn.y + rgn.h), bl(rgn.x, rgn.y + rgn.h);
+		triangles.push_back(tl);
+		triangles.push_back(tr);
+		triangles.push_back(br);
+		triangles.push_back(tl);
+		triangles.push_back(br);
+		triangles.push_back(bl);
+	}
+	drawPolygon(&triangles[0], triangles.size(), color, FilledTriangulation);
+}
+
 void GLVideoDriver::drawEllipse(int cx /*center*/, int cy /*center*/, unsigned short xr, unsigned short yr, float thickness, const Color& color)
 {
 	glDisable(GL_SCISSOR_TEST);
@@ -482,10 +585,7 @@ void GLVideoDriver::drawEllipse(int cx /*center*/, int cy /*center*/, unsigned s
 		-1.0f,-1.0f, -1.0f,-1.0f,
 		 1.0f,-1.0f,  1.0f,-1.0f
 	};
-	GLuint buffer;
-	glGenBuffers(1, &buffer);
-	glBindBuffer(GL_ARRAY_BUFFER, buffer);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
+	streamVertices(data, sizeof(data));
 
 	GLint a_position = programEllipse->GetAttribLocation("a_position");
 	GLint a_texCoord = programEllipse->GetAttribLocation("a_texCoord");
@@ -505,7 +605,6 @@ void GLVideoDriver::drawEllipse(int cx /*center*/, int cy /*center*/, unsigned s
 	glDisableVertexAttribArray(a_texCoord);
 	glDisableVertexAttribArray(a_position);
 
-	glDeleteBuffers(1, &buffer);
 	glEnable(GL_SCISSOR_TEST);
 }
 
@@ -580,42 +679,12 @@ void GLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y, unsigned i
 		ty -= Viewport.y;
 	}
 	GLTextureSprite2D* glSprite = (GLTextureSprite2D*)spr;
-	GLuint coverTexture = 0;
 
-	if(glSprite->IsPaletted())
+	if (glSprite->IsPaletted() && cover)
 	{
-		if (cover)
-		{
-			int trueX = cover->XPos - glSprite->XPos;
-			int trueY = cover->YPos - glSprite->YPos;
-			Uint8* data = new Uint8[glSprite->Width*glSprite->Height];
-			Uint8* coverPointer = &cover->pixels[trueY*glSprite->Width + trueX];
-			Uint8* dataPointer = data;
-			for(int h=0; h<glSprite->Height; h++)
-			{
-				for(int w=0; w<glSprite->Width; w++)
-				{
-					*dataPointer = !(*coverPointer) * 255;
-					dataPointer++;
-					coverPointer++;
-				}
-				coverPointer += cover->Width - glSprite->Width;
-			}
-			glActiveTexture(GL_TEXTURE2);
-			glGenTextures(1, &coverTexture);
-			glBindTexture(GL_TEXTURE_2D, coverTexture);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-#ifdef USE_GL
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-#endif
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, glSprite->Width, glSprite->Height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, (GLvoid*) data);
-			delete[] data;
-			flags |= BLIT_EXTERNAL_MASK;
-		}
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, getCoverTexture(cover, glSprite));
+		flags |= BLIT_EXTERNAL_MASK;
 	}
 
 	int w = glSprite->Width, h = glSprite->Height, dx = 0, dy = 0;
@@ -634,14 +703,81 @@ void GLVideoDriver::BlitGameSprite(const Sprite2D* spr, int x, int y, unsigned i
 		GLBlitSprite(glSprite, src, dst, palette, flags);
 	else
 		GLBlitSprite(glSprite, src, dst, palette, flags, &tint);
-	if (coverTexture != 0)
+	if (flags & BLIT_EXTERNAL_MASK)
 	{
 		glActiveTexture(GL_TEXTURE2);
 		glBindTexture(GL_TEXTURE_2D, 0);
-		glDeleteTextures(1, &coverTexture);
 	}
 }
 
+// covers only change by being recreated, so the mask of each sprite
+// frame drawn with one needs to be uploaded just once
+GLuint GLVideoDriver::getCoverTexture(const SpriteCover* cover, const GLTextureSprite2D* spr)
+{
+	std::vector<CoverTexture>& textures = coverTextures[cover];
+	for (size_t i = 0; i < textures.size(); i++) {
+		const CoverTexture& ct = textures[i];
+		if (ct.pixels == cover->pixels && ct.XPos == spr->XPos && ct.YPos == spr->YPos
+			&& ct.Width == spr->Width && ct.Height == spr->Height) {
+			return ct.texture;
+		}
+	}
+
+	int trueX = cover->XPos - spr->XPos;
+	int trueY = cover->YPos - spr->YPos;
+	Uint8* data = new Uint8[spr->Width*spr->Height];
+	const Uint8* coverPointer = &cover->pixels[trueY*cover->Width + trueX];
+	Uint8* dataPointer = data;
+	for(int h=0; h<spr->Height; h++)
+	{
+		for(int w=0; w<spr->Width; w++)
+		{
+			*dataPointer = !(*coverPointer) * 255;
+			dataPointer++;
+			coverPointer++;
+		}
+		coverPointer += cover->Width - spr->Width;
+	}
+
+	CoverTexture ct;
+	ct.pixels = cover->pixels;
+	ct.XPos = spr->XPos;
+	ct.YPos = spr->YPos;
+	ct.Width = spr->Width;
+	ct.Height = spr->Height;
+	glActiveTexture(GL_TEXTURE2);
+	glGenTextures(1, &ct.texture);
+	glBindTexture(GL_TEXTURE_2D, ct.texture);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#ifdef USE_GL
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, spr->Width, spr->Height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, (GLvoid*) data);
+	delete[] data;
+	textures.push_back(ct);
+	return ct.texture;
+}
+
+void GLVideoDriver::freeCoverTextures(const SpriteCover* cover)
+{
+	std::map<const SpriteCover*, std::vector<CoverTexture> >::iterator it = coverTextures.find(cover);
+	if (it == coverTextures.end()) return;
+	for (size_t i = 0; i < it->second.size(); i++) {
+		glDeleteTextures(1, &it->second[i].texture);
+	}
+	coverTextures.erase(it);
+}
+
+void GLVideoDriver::DestroySpriteCover(SpriteCover* sc)
+{
+	freeCoverTextures(sc);
+	SDL20VideoDriver::DestroySpriteCover(sc);
+}
+
 void GLVideoDriver::DrawRect(const Region& rgn, const Color& color, bool fill, bool clipped)
 {
 	if (fill && SDL_ALPHA_OPAQUE == color.a)
@@ -4,6 +4,9 @@
 
 #include "SDL20Video.h"
 
+#include <map>
+#include <vector>
+
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 #define VERTEX_SIZE 2
 #define TEX_SIZE 2
@@ -22,7 +25,9 @@ namespace GemRB
 		LineStrip,
 		LineLoop,
 		ConvexFilledPolygon,
-		FilledTriangulation
+		FilledTriangulation,
+		Points,
+		Lines
 	};
 
 	class GLVideoDriver : public SDL20VideoDriver 
@@ -45,14 +50,29 @@ namespace GemRB
 		GLTextureSprite2D *backgroundBuffer;
 		Region GLViewport;
 
+		unsigned int streamBuffer; // vertex buffer reused by every streamed draw
+
+		// uploaded cover masks, one per sprite frame drawn with the cover
+		struct CoverTexture
+		{
+			unsigned int texture;
+			const unsigned char* pixels;
+			int XPos, YPos, Width, Height;
+		};
+		std::map<const SpriteCover*, std::vector<CoverTexture> > coverTextures;
+
 		void useProgram(GLSLProgram* program); // use this instead program->Use()
 		bool createPrograms();
 		void GLBlitSprite(GLTextureSprite2D* spr, const Region& src, const Region& dst, Palette* attachedPal = NULL, unsigned int flags = 0, const Color* tint = NULL, GLTextureSprite2D* mask = NULL);
 		void clearRect(const Region& rgn, const Color& color);
 		void drawEllipse(int cx, int cy, unsigned short xr, unsigned short yr, float thickness, const Color& color);
 		void drawPolygon(Point* points, unsigned int count, const Color& color, PointDrawingMode mode);
+		void streamVertices(const void* data, unsigned int size);
+		unsigned int getCoverTexture(const SpriteCover* cover, const GLTextureSprite2D* spr);
+		void freeCoverTextures(const SpriteCover* cover);
 
 	public:
+		GLVideoDriver();
 		~GLVideoDriver();
 		int SwapBuffers();
 		int CreateDisplay(int w, int h, int b, bool fs, const char* title);
@@ -71,8 +91,12 @@ namespace GemRB
 		void DrawEllipse(short cx, short cy, unsigned short xr, unsigned short yr, const Color& color, bool clipped = true);
 		void DrawCircle(short cx, short cy, unsigned short r, const Color& color, bool clipped = true);
 		void SetPixel(short x, short y, const Color& color, bool clipped = true);
+		void DrawPoints(const Point* points, const Color* colors, unsigned int count, bool clipped = true);
+		void DrawLines(const Point* points, const Color* colors, unsigned int count, bool clipped = false);
+		void DrawRects(const Region* rgns, unsigned int count, const Color& color);
 		/*void DrawEllipseSegment(short cx, short cy, unsigned short xr, unsigned short yr, const Color& color, double anglefrom, double angleto, bool drawlines = true, bool clipped = true);*/
 		void DestroyMovieScreen();
+		void DestroySpriteCover(SpriteCover* sc);
 		Sprite2D* GetScreenshot(Region r);
 
 		void DrawBackgroundBuffer();
@@ -1077,6 +1077,180 @@ void SDLVideoDriver::DrawCircle(short cx, short cy, unsigned short r,
 	}
 }
 
+void SDLVideoDriver::DrawPoints(const Point* points, const Color* colors, unsigned int count, bool clipped)
+{
+	if (!count) {
+		return;
+	}
+
+	// same clipping rules as SetPixel, but checked against a precomputed box
+	int xoff = 0, yoff = 0;
+	int minx = 0, miny = 0, maxx = disp->w, maxy = disp->h;
+	if (clipped) {
+		xoff = xCorr;
+		yoff = yCorr;
+		minx = xCorr;
+		miny = yCorr;
+		maxx = xCorr + Viewport.w;
+		maxy = yCorr + Viewport.h;
+	}
+
+	SDL_PixelFormat* fmt = backBuf->format;
+	Color lastColor = colors[0];
+	Uint32 val = SDL_MapRGBA( fmt, lastColor.r, lastColor.g, lastColor.b, lastColor.a );
+
+	SDL_LockSurface( backBuf );
+	for (unsigned int i = 0; i < count; i++) {
+		int x = points[i].x + xoff;
+		int y = points[i].y + yoff;
+		if (x < minx || y < miny || x >= maxx || y >= maxy) {
+			continue;
+		}
+		if (colors[i] != lastColor) {
+			lastColor = colors[i];
+			val = SDL_MapRGBA( fmt, lastColor.r, lastColor.g, lastColor.b, lastColor.a );
+		}
+		PutSurfacePixel(backBuf, x, y, val);
+	}
+	SDL_UnlockSurface( backBuf );
+}
+
+void SDLVideoDriver::DrawCircles(const Point* centers, const Color* colors, unsigned int count,
+	unsigned short r, bool clipped)
+{
+	if (!count) {
+		return;
+	}
+
+	// an octant of the circle is the same for every center, so compute it once
+	std::vector<Point> octant;
+	long x = r, y = 0, xc = 1 - ( 2 * r ), yc = 1, re = 0;
+	while (x >= y) {
+		octant.push_back(Point((short) x, (short) y));
+		y++;
+		re += yc;
+		yc += 2;
+		if (( ( 2 * re ) + xc ) > 0) {
+			x--;
+			re += xc;
+			xc += 2;
+		}
+	}
+
+	std::vector<Point> pixels;
+	std::vector<Color> pixelColors;
+	pixels.reserve(count * octant.size() * 8);
+	pixelColors.reserve(count * octant.size() * 8);
+	for (unsigned int i = 0; i < count; i++) {
+		short cx = centers[i].x;
+		short cy = centers[i].y;
+		for (size_t j = 0; j < octant.size(); j++) {
+			short ox = octant[j].x;
+			short oy = octant[j].y;
+			pixels.push_back(Point(cx + ox, cy + oy));
+			pixels.push_back(Point(cx - ox, cy + oy));
+			pixels.push_back(Point(cx - ox, cy - oy));
+			pixels.push_back(Point(cx + ox, cy - oy));
+			pixels.push_back(Point(cx + oy, cy + ox));
+			pixels.push_back(Point(cx - oy, cy + ox));
+			pixels.push_back(Point(cx - oy, cy - ox));
+			pixels.push_back(Point(cx + oy, cy - ox));
+		}
+		pixelColors.insert(pixelColors.end(), octant.size() * 8, colors[i]);
+	}
+	DrawPoints(&pixels[0], &pixelColors[0], (unsigned int) pixels.size(), clipped);
+}
+
+// the same fixed point stepping as DrawLine, collecting pixels instead of plotting them
+static void RasterizeLine(int x1, int y1, int x2, int y2, std::vector<Point>& pixels)
+{
+	bool yLonger = false;
+	int shortLen = y2 - y1;
+	int longLen = x2 - x1;
+	if (abs( shortLen ) > abs( longLen )) {
+		int swap = shortLen;
+		shortLen = longLen;
+		longLen = swap;
+		yLonger = true;
+	}
+	int decInc = longLen ? ( shortLen << 16 ) / longLen : 0;
+	int step = longLen >= 0 ? 1 : -1;
+	int j = 0x8000 + ( ( yLonger ? x1 : y1 ) << 16 );
+	int i = yLonger ? y1 : x1;
+	int end = i + longLen;
+	for (;; i += step) {
+		if (yLonger) {
+			pixels.push_back(Point(j >> 16, i));
+		} else {
+			pixels.push_back(Point(i, j >> 16));
+		}
+		if (i == end) {
+			break;
+		}
+		j += step * decInc;
+	}
+}
+
+void SDLVideoDriver::DrawLines(const Point* points, const Color* colors, unsigned int count, bool clipped)
+{
+	if (!count) {
+		return;
+	}
+
+	int xoff = 0, yoff = 0;
+	if (clipped) {
+		xoff = Viewport.x;
+		yoff = Viewport.y;
+	}
+
+	std::vector<Point> pixels;
+	std::vector<Color> pixelColors;
+	for (unsigned int i = 0; i < count; i++) {
+		size_t start = pixels.size();
+		RasterizeLine(points[2*i].x - xoff, points[2*i].y - yoff,
+			points[2*i+1].x - xoff, points[2*i+1].y - yoff, pixels);
+		pixelColors.insert(pixelColors.end(), pixels.size() - start, colors[i]);
+	}
+	if (pixels.empty()) {
+		return;
+	}
+	DrawPoints(&pixels[0], &pixelColors[0], (unsigned int) pixels.size(), clipped);
+}
+
+void SDLVideoDriver::DrawRects(const Region* rgns, unsigned int count, const Color& color)
+{
+	if (!count || SDL_ALPHA_TRANSPARENT == color.a) {
+		return;
+	}
+
+	if (SDL_ALPHA_OPAQUE == color.a) {
+		long val = SDL_MapRGBA( backBuf->format, color.r, color.g, color.b, color.a );
+		for (unsigned int i = 0; i < count; i++) {
+			SDL_Rect drect = RectFromRegion(ClippedDrawingRect(rgns[i]));
+			SDL_FillRect( backBuf, &drect, val );
+		}
+		return;
+	}
+
+	// translucent: reuse a single blending surface for the whole batch
+	int w = 0, h = 0;
+	for (unsigned int i = 0; i < count; i++) {
+		if (rgns[i].w > w) w = rgns[i].w;
+		if (rgns[i].h > h) h = rgns[i].h;
+	}
+	SDL_Surface * rectsurf = SDL_CreateRGBSurface( SDL_SWSURFACE | SDL_SRCALPHA, w, h, 8, 0, 0, 0, 0 );
+	SDL_Color c;
+	c.r = color.r;
+	c.b = color.b;
+	c.g = color.g;
+	SetSurfacePalette(rectsurf, &c, 1);
+	SetSurfaceAlpha(rectsurf, color.a);
+	for (unsigned int i = 0; i < count; i++) {
+		BlitSurfaceClipped(rectsurf, Region(0, 0, rgns[i].w, rgns[i].h), rgns[i]);
+	}
+	SDL_FreeSurface( rectsurf );
+}
+
 static double ellipseradius(unsigned short xr, unsigned short yr, double angle) {
 	double one = (xr * sin(angle));
 	double two = (yr * cos(angle));
@@ -1494,14 +1668,20 @@ void SDLVideoDriver::SetSurfacePalette(SDL_Surface* surf, SDL_Color* pal, int nu
 }
 
 void SDLVideoDriver::SetSurfacePixel(SDL_Surface* surface, short x, short y, const Color& color)
+{
+	Uint32 val = SDL_MapRGBA( surface->format, color.r, color.g, color.b, color.a );
+	SDL_LockSurface( surface );
+	PutSurfacePixel(surface, x, y, val);
+	SDL_UnlockSurface( surface );
+}
+
+// writes an already mapped pixel value; the caller is responsible for locking
+void SDLVideoDriver::PutSurfacePixel(SDL_Surface* surface, short x, short y, Uint32 val)
 {
 	SDL_PixelFormat* fmt = surface->format;
 	unsigned char * pixels = ( ( unsigned char * ) surface->pixels ) +
 	( ( y * surface->w + x) * fmt->BytesPerPixel );
 
-	Uint32 val = SDL_MapRGBA( fmt, color.r, color.g, color.b, color.a );
-	SDL_LockSurface( surface );
-
 	switch (fmt->BytesPerPixel) {
 		case 1:
 			*pixels = (unsigned char)val;
@@ -1527,8 +1707,6 @@ void SDLVideoDriver::SetSurfacePixel(SDL_Surface* surface, short x, short y, con
 			Log(ERROR, "SDLSurfaceSprite2D", "Working with unknown pixel format: %s", SDL_GetError());
 			break;
 	}
-
-	SDL_UnlockSurface( surface );
 }
 
 void SDLVideoDriver::GetSurfacePixel(SDL_Surface* surface, short x, short y, Color& c)
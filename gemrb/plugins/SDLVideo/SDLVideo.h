@@ -84,7 +84,6 @@ public:
 	
 	void InitSpriteCover(SpriteCover* sc, int flags);
 	void AddPolygonToSpriteCover(SpriteCover* sc, Wall_Polygon* poly);
-	void DestroySpriteCover(SpriteCover* sc);
 
 	void MouseMovement(int x, int y);
 	void ClickMouse(unsigned int button);
@@ -128,6 +127,11 @@ public:
 	virtual void DrawHLine(short x1, short y, short x2, const Color& color, bool clipped = false);
 	virtual void DrawVLine(short x, short y1, short y2, const Color& color, bool clipped = false);
 	virtual void DrawLine(short x1, short y1, short x2, short y2, const Color& color, bool clipped = false);
+	virtual void DrawPoints(const Point* points, const Color* colors, unsigned int count, bool clipped = true);
+	virtual void DrawCircles(const Point* centers, const Color* colors, unsigned int count,
+		unsigned short r, bool clipped = true);
+	virtual void DrawLines(const Point* points, const Color* colors, unsigned int count, bool clipped = false);
+	virtual void DrawRects(const Region* rgns, unsigned int count, const Color& color);
 	/** Blits a Sprite filling the Region */
 	void BlitTiled(Region rgn, const Sprite2D* img, bool anchor = false);
 
@@ -176,6 +180,7 @@ public:
 	// static functions for manipulating surfaces
 	static void SetSurfacePalette(SDL_Surface* surf, SDL_Color* pal, int numcolors = 256);
 	static void SetSurfacePixel(SDL_Surface* surf, short x, short y, const Color& color);
+	static void PutSurfacePixel(SDL_Surface* surf, short x, short y, Uint32 val);
 	static void GetSurfacePixel(SDL_Surface* surf, short x, short y, Color& c);
 
 	// we need to beable to convert between Region and SDL_Rect
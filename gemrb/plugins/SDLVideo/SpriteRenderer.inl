@@ -339,8 +339,9 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 
 
 	// Clipping strategy:
-	// Because we can't jump to the right spot in the RLE data,
-	// we have to process the full sprite.
+	// We can't jump to an arbitrary pixel in the RLE data, but when the
+	// sprite has a row index we can start at the first visible row.
+	// Otherwise we have to process the full sprite.
 	// We fast-forward through the bits outside of the clipping rectangle.
 
 	// This is done line-by-line.
@@ -393,6 +394,24 @@ static void BlitSpriteRLE_internal(SDL_Surface* target,
 	const int yfactor = yflip ? -1 : 1;
 	const int xfactor = XFLIP ? -1 : 1;
 
+	// skip the rows above (or below, when flipped) the clipping rectangle
+	int skiprows = yflip ? ty + height - clip.y - clip.h : clip.y - ty;
+	const RLERowOffset* rows = NULL;
+	if (skiprows > 0 && width == spr->Width && height == spr->Height) {
+		rows = spr->GetRLERowIndex();
+	}
+	if (rows) {
+		const RLERowOffset& row = rows[skiprows];
+		srcdata += row.offset;
+		line += yfactor * skiprows * pitch;
+		// the code at the offset may be a run that starts in the previous row
+		pix += yfactor * skiprows * pitch - xfactor * row.lead;
+		clipstartpix += yfactor * skiprows * pitch;
+		clipendpix += yfactor * skiprows * pitch;
+		if (COVER)
+			coverpix += yfactor * skiprows * cover->Width - xfactor * row.lead;
+	}
+
 	while (line != end) {
 
 		// Fast-forward through the RLE data until we reach clipstartpix